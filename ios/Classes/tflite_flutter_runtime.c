@@ -0,0 +1,5 @@
+// Forwarder file that includes the runtime helpers implementation.
+// This is necessary because CocoaPods doesn't support relative paths
+// outside the pod directory in source_files.
+
+#include "../../src/runtime/tflite_flutter_runtime.c"
@@ -8,6 +8,10 @@ library flutter_litert;
 import 'package:ffi/ffi.dart';
 import 'package:flutter_litert/src/bindings/bindings.dart';
 
+export 'src/adaptive_interpreter_pool.dart';
+export 'src/auto_tune.dart';
+export 'src/batching_interpreter.dart';
+export 'src/compute_threads.dart';
 export 'src/delegate.dart';
 export 'src/delegates/gpu_delegate.dart';
 export 'src/delegates/metal_delegate.dart';
@@ -15,11 +19,21 @@ export 'src/delegates/xnnpack_delegate.dart';
 export 'src/delegates/coreml_delegate.dart';
 export 'src/interpreter.dart';
 export 'src/interpreter_options.dart';
+export 'src/interpreter_pool.dart';
 export 'src/isolate_interpreter.dart';
+export 'src/model.dart';
+export 'src/model_cache.dart';
+export 'src/native_buffer.dart';
 export 'src/quanitzation_params.dart';
+export 'src/shape_cached_interpreter.dart';
+export 'src/signature_runner.dart';
 export 'src/tensor.dart';
+export 'src/tensor_view.dart';
+export 'src/thread_placement.dart';
 export 'src/util/byte_conversion_utils.dart';
 export 'src/util/list_shape_extension.dart';
+export 'src/util/nested_list_view.dart';
+export 'src/util/zstd_decoder.dart';
 export 'src/custom_ops/transpose_conv_bias.dart';
 
 /// LiteRT version information.
@@ -0,0 +1,352 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:async';
+
+import 'package:quiver/check.dart';
+
+import 'compute_threads.dart';
+import 'interpreter_options.dart';
+import 'interpreter_pool.dart';
+import 'model.dart';
+import 'tensor_view.dart';
+
+/// One split of a thread budget: [interpreters] interpreters running
+/// requests in parallel, each with [threads] intra-op threads.
+class ConcurrencyLevel {
+  const ConcurrencyLevel(this.interpreters, this.threads);
+
+  /// Splits [budget] threads from one interpreter with every thread to one
+  /// single-threaded interpreter per thread, halving the threads per
+  /// interpreter at each step.
+  static List<ConcurrencyLevel> levelsFor(int budget) {
+    checkArgument(budget > 0, message: 'Thread budget must be positive');
+    final levels = <ConcurrencyLevel>[];
+    for (var threads = budget;; threads ~/= 2) {
+      levels.add(ConcurrencyLevel(budget ~/ threads, threads));
+      if (threads == 1) {
+        return levels;
+      }
+    }
+  }
+
+  final int interpreters;
+  final int threads;
+
+  @override
+  bool operator ==(Object other) =>
+      other is ConcurrencyLevel &&
+      other.interpreters == interpreters &&
+      other.threads == threads;
+
+  @override
+  int get hashCode => Object.hash(interpreters, threads);
+
+  @override
+  String toString() => '${interpreters}x$threads';
+}
+
+/// Load observed by [AdaptiveInterpreterPool] over one control interval.
+class ConcurrencySample {
+  const ConcurrencySample({
+    required this.requests,
+    required this.meanQueueDepth,
+    required this.interpreters,
+    required this.p95Micros,
+  });
+
+  /// Requests completed during the interval.
+  final int requests;
+
+  /// Mean number of requests outstanding when a request was submitted,
+  /// itself included.
+  final double meanQueueDepth;
+
+  /// Interpreters serving requests during the interval.
+  final int interpreters;
+
+  /// 95th percentile request latency, queueing included.
+  final int p95Micros;
+
+  /// Outstanding requests per interpreter: above 1 requests wait for a
+  /// free interpreter, well below 1 interpreters sit idle.
+  double get saturation => meanQueueDepth / interpreters;
+}
+
+/// Decides when [AdaptiveInterpreterPool] moves between
+/// [ConcurrencyLevel]s.
+///
+/// Levels are ordered from fewest to most interpreters. The policy moves to
+/// more interpreters while requests queue up ([ConcurrencySample.saturation]
+/// above [highSaturation]) and to more threads per interpreter while
+/// interpreters idle (below [lowSaturation]). A move that raises p95
+/// latency by more than [regressionTolerance] without a matching rise in
+/// load is undone, and that direction is held off for [holdIntervals].
+class ConcurrencyPolicy {
+  ConcurrencyPolicy({
+    this.highSaturation = 1.0,
+    this.lowSaturation = 0.5,
+    this.regressionTolerance = 0.2,
+    this.holdIntervals = 5,
+  }) {
+    checkArgument(lowSaturation < highSaturation,
+        message: 'lowSaturation must be below highSaturation');
+  }
+
+  final double highSaturation;
+  final double lowSaturation;
+  final double regressionTolerance;
+  final int holdIntervals;
+
+  int _lastMove = 0;
+  int _p95BeforeMove = 0;
+  double _saturationBeforeMove = 0;
+  int _blockedMove = 0;
+  int _holdRemaining = 0;
+
+  /// Returns the level to use after an interval at [level] of [levelCount]
+  /// that produced [sample].
+  int next(int level, int levelCount, ConcurrencySample sample) {
+    if (sample.requests == 0) {
+      return level;
+    }
+    final saturation = sample.saturation;
+    if (_lastMove != 0) {
+      final move = _lastMove;
+      _lastMove = 0;
+      final slower =
+          sample.p95Micros > _p95BeforeMove * (1 + regressionTolerance);
+      final busier =
+          saturation > _saturationBeforeMove * (1 + regressionTolerance);
+      if (slower && !busier) {
+        _blockedMove = move;
+        _holdRemaining = holdIntervals;
+        return (level - move).clamp(0, levelCount - 1);
+      }
+    }
+    if (_holdRemaining > 0) {
+      _holdRemaining--;
+    } else {
+      _blockedMove = 0;
+    }
+
+    var move = 0;
+    if (saturation > highSaturation && level < levelCount - 1) {
+      move = 1;
+    } else if (saturation < lowSaturation && level > 0) {
+      move = -1;
+    }
+    if (move == 0 || move == _blockedMove) {
+      return level;
+    }
+    _lastMove = move;
+    _p95BeforeMove = sample.p95Micros;
+    _saturationBeforeMove = saturation;
+    return level + move;
+  }
+
+  /// Tells the policy that the move returned by the last [next] call could
+  /// not be made, so the next interval is not judged as its outcome.
+  void moveFailed() {
+    _lastMove = 0;
+  }
+}
+
+/// [InterpreterPool] that shifts a fixed thread budget between intra-op
+/// threads and the number of interpreters as load changes.
+///
+/// A single interpreter with every thread gives the lowest latency while
+/// requests arrive one at a time; under a steady stream, one
+/// single-threaded interpreter per core gives the highest throughput. Every
+/// [interval] the pool samples queue depth and p95 latency and asks its
+/// [ConcurrencyPolicy] for a [ConcurrencyLevel]. A new level is built as a
+/// replacement pool while the current one keeps serving; its interpreters
+/// are created and allocated on their own worker isolates (see
+/// [InterpreterPool.create]), so only the options are made on the calling
+/// isolate. New requests switch over once it is ready, and the old pool
+/// closes after its requests in flight complete.
+class AdaptiveInterpreterPool {
+  AdaptiveInterpreterPool._(this._model, this.levels, this._createOptions,
+      this.policy, this.debugName);
+
+  /// Creates an adaptive pool for [model] starting at [initialLevel] of
+  /// [ConcurrencyLevel.levelsFor] the [threadBudget].
+  ///
+  /// [threadBudget] defaults to [ComputeThreads.maxExtraThreads] plus the
+  /// calling thread. Interpreters get options from [createOptions] for
+  /// their number of threads, or default options with
+  /// [InterpreterOptions.threads] set; [createOptions] runs on the calling
+  /// isolate and should only configure options, since the interpreters are
+  /// built on the worker isolates. The pool holds its own reference to
+  /// [model], so the caller may delete it right away.
+  static Future<AdaptiveInterpreterPool> create(
+    Model model, {
+    int? threadBudget,
+    int initialLevel = 0,
+    Duration interval = const Duration(seconds: 1),
+    ConcurrencyPolicy? policy,
+    InterpreterOptions Function(int threads)? createOptions,
+    String debugName = 'TfLiteAdaptivePool',
+  }) async {
+    final levels = ConcurrencyLevel.levelsFor(
+        threadBudget ?? ComputeThreads.maxExtraThreads + 1);
+    RangeError.checkValidIndex(initialLevel, levels, 'initialLevel');
+    model.retain();
+    final pool = AdaptiveInterpreterPool._(model, levels,
+        createOptions ?? _defaultOptions, policy ?? ConcurrencyPolicy(),
+        debugName);
+    try {
+      pool._pool = await pool._createPool(levels[initialLevel]);
+    } catch (_) {
+      model.release();
+      rethrow;
+    }
+    pool._level = initialLevel;
+    pool._timer = Timer.periodic(interval, (_) => pool.evaluate());
+    return pool;
+  }
+
+  static InterpreterOptions _defaultOptions(int threads) =>
+      InterpreterOptions()..threads = threads;
+
+  final Model _model;
+  final InterpreterOptions Function(int threads) _createOptions;
+
+  /// Levels the pool moves between, from fewest to most interpreters.
+  final List<ConcurrencyLevel> levels;
+
+  final ConcurrencyPolicy policy;
+  final String debugName;
+
+  late InterpreterPool _pool;
+  late int _level;
+  Timer? _timer;
+  Future<void>? _swapping;
+  final Set<Future<void>> _retiring = <Future<void>>{};
+  bool _closed = false;
+  int _switchCount = 0;
+
+  int _outstanding = 0;
+  int _submitted = 0;
+  int _depthSum = 0;
+  final List<int> _latencies = <int>[];
+  ConcurrencySample? _lastSample;
+
+  /// Level serving new requests.
+  ConcurrencyLevel get level => levels[_level];
+
+  /// Number of times a replacement pool was swapped in.
+  int get switchCount => _switchCount;
+
+  /// Requests submitted and not yet completed.
+  int get queueDepth => _outstanding;
+
+  /// Sample of the last completed control interval.
+  ConcurrencySample? get lastSample => _lastSample;
+
+  /// Runs [inputs] on the current pool; see [InterpreterPool.run].
+  Future<List<TensorView>> run(List<Object> inputs,
+      {List<int>? outputIndexes}) async {
+    checkState(!_closed, message: 'AdaptiveInterpreterPool already closed.');
+    _outstanding++;
+    _submitted++;
+    _depthSum += _outstanding;
+    final stopwatch = Stopwatch()..start();
+    try {
+      return await _pool.run(inputs, outputIndexes: outputIndexes);
+    } finally {
+      _outstanding--;
+      _latencies.add(stopwatch.elapsedMicroseconds);
+    }
+  }
+
+  /// Ends the current control interval and starts a swap if the policy
+  /// picks another level. Called every `interval`; calling it directly
+  /// forces an early decision.
+  void evaluate() {
+    if (_closed || _swapping != null) {
+      return;
+    }
+    final sample = _takeSample();
+    _lastSample = sample;
+    final next = policy.next(_level, levels.length, sample);
+    if (next != _level) {
+      _swapping = _swapTo(next).whenComplete(() => _swapping = null);
+    }
+  }
+
+  /// Stops adapting, waits for requests in flight and closes every
+  /// interpreter.
+  Future<void> close() async {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    _timer?.cancel();
+    _timer = null;
+    await _swapping;
+    await _pool.close();
+    await Future.wait(List.of(_retiring));
+    _model.release();
+  }
+
+  ConcurrencySample _takeSample() {
+    _latencies.sort();
+    final count = _latencies.length;
+    final sample = ConcurrencySample(
+      requests: count,
+      meanQueueDepth: _submitted == 0 ? 0 : _depthSum / _submitted,
+      interpreters: level.interpreters,
+      p95Micros:
+          count == 0 ? 0 : _latencies[((count * 95 + 99) ~/ 100) - 1],
+    );
+    _latencies.clear();
+    _submitted = 0;
+    _depthSum = 0;
+    return sample;
+  }
+
+  Future<void> _swapTo(int next) async {
+    final InterpreterPool replacement;
+    try {
+      replacement = await _createPool(levels[next]);
+    } catch (_) {
+      // Keep serving at the current level; the policy may retry later.
+      policy.moveFailed();
+      return;
+    }
+    if (_closed) {
+      await replacement.close();
+      return;
+    }
+    final retired = _pool;
+    _pool = replacement;
+    _level = next;
+    _switchCount++;
+    // Requests of the old level are not representative of the new one.
+    _takeSample();
+    late final Future<void> closing;
+    closing = retired.close().whenComplete(() => _retiring.remove(closing));
+    _retiring.add(closing);
+  }
+
+  Future<InterpreterPool> _createPool(ConcurrencyLevel level) {
+    return InterpreterPool.create(_model,
+        size: level.interpreters,
+        createOptions: () => _createOptions(level.threads),
+        debugName: '$debugName-${level.interpreters}x${level.threads}');
+  }
+}
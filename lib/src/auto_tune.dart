@@ -0,0 +1,520 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:path/path.dart' as p;
+import 'package:quiver/check.dart';
+
+import 'delegates/xnnpack_delegate.dart';
+import 'ffi/helper.dart';
+import 'interpreter.dart';
+import 'interpreter_options.dart';
+import 'model.dart';
+import 'model_cache.dart';
+import 'tensor.dart';
+
+/// One interpreter configuration tried by [Interpreter.autoTune]: a number
+/// of CPU threads, optionally with the XNNPack delegate and its flags.
+class TuningCandidate {
+  const TuningCandidate({
+    this.threads = 1,
+    this.xnnpack = false,
+    this.enableQS8 = false,
+    this.enableQU8 = false,
+    this.forceFP16 = false,
+  });
+
+  /// Reads a candidate written by [toJson].
+  factory TuningCandidate.fromJson(Map<String, Object?> json) {
+    return TuningCandidate(
+      threads: json['threads'] as int,
+      xnnpack: json['xnnpack'] as bool,
+      enableQS8: json['qs8'] as bool,
+      enableQU8: json['qu8'] as bool,
+      forceFP16: json['fp16'] as bool,
+    );
+  }
+
+  /// Default CPU configuration with one thread; the fp32 reference every
+  /// other candidate is checked against.
+  static const TuningCandidate baseline = TuningCandidate();
+
+  /// Default CPU and XNNPack configurations, the latter plain, with quantized
+  /// operators and with half-precision float operators, each with 1, 2, 4,
+  /// ... threads up to [maxThreads] (by default the number of processors).
+  static List<TuningCandidate> defaults({int? maxThreads}) {
+    final limit = maxThreads ?? Platform.numberOfProcessors;
+    checkArgument(limit > 0, message: 'maxThreads must be positive');
+    final threads = <int>[
+      for (var t = 1; t < limit; t *= 2) t,
+      limit,
+    ];
+    return [
+      for (final t in threads) ...[
+        TuningCandidate(threads: t),
+        TuningCandidate(threads: t, xnnpack: true),
+        TuningCandidate(
+            threads: t, xnnpack: true, enableQS8: true, enableQU8: true),
+        TuningCandidate(threads: t, xnnpack: true, forceFP16: true),
+      ],
+    ];
+  }
+
+  /// Number of CPU threads of the interpreter and delegate.
+  final int threads;
+
+  /// Whether the XNNPack delegate is added.
+  final bool xnnpack;
+
+  /// See [XNNPackDelegateOptions].
+  final bool enableQS8;
+
+  /// See [XNNPackDelegateOptions].
+  final bool enableQU8;
+
+  /// See [XNNPackDelegateOptions].
+  final bool forceFP16;
+
+  /// Short name such as `cpu-t4` or `xnnpack-t2-qs8-fp16`.
+  String get id {
+    final buffer = StringBuffer(xnnpack ? 'xnnpack' : 'cpu')
+      ..write('-t$threads');
+    if (xnnpack) {
+      if (enableQS8) {
+        buffer.write('-qs8');
+      }
+      if (enableQU8) {
+        buffer.write('-qu8');
+      }
+      if (forceFP16) {
+        buffer.write('-fp16');
+      }
+    }
+    return buffer.toString();
+  }
+
+  Map<String, Object?> toJson() => {
+        'threads': threads,
+        'xnnpack': xnnpack,
+        'qs8': enableQS8,
+        'qu8': enableQU8,
+        'fp16': forceFP16,
+      };
+
+  /// Creates an interpreter for [model] with this configuration.
+  ///
+  /// If the XNNPack delegate cannot be created or applied, falls back to
+  /// the default CPU configuration with the same number of threads; see
+  /// [TunedInterpreter.candidate].
+  TunedInterpreter build(Model model) {
+    try {
+      return _build(model);
+    } catch (_) {
+      if (!xnnpack) {
+        rethrow;
+      }
+    }
+    return TuningCandidate(threads: threads)._build(model);
+  }
+
+  TunedInterpreter _build(Model model) {
+    final options = InterpreterOptions()..threads = threads;
+    XNNPackDelegate? delegate;
+    try {
+      if (xnnpack) {
+        final delegateOptions = XNNPackDelegateOptions(
+            numThreads: threads,
+            enableQS8: enableQS8,
+            enableQU8: enableQU8,
+            forceFP16: forceFP16);
+        delegate = XNNPackDelegate(options: delegateOptions);
+        delegateOptions.delete();
+        checkState(isNotNull(delegate.base),
+            message: 'Unable to create XNNPack delegate.');
+        options.addDelegate(delegate);
+      }
+      final interpreter = Interpreter.fromModel(model, options: options);
+      return TunedInterpreter._(this, interpreter, options, delegate);
+    } catch (_) {
+      if (delegate != null && isNotNull(delegate.base)) {
+        delegate.delete();
+      }
+      options.delete();
+      rethrow;
+    }
+  }
+
+  @override
+  bool operator ==(Object other) =>
+      other is TuningCandidate &&
+      other.threads == threads &&
+      other.xnnpack == xnnpack &&
+      other.enableQS8 == enableQS8 &&
+      other.enableQU8 == enableQU8 &&
+      other.forceFP16 == forceFP16;
+
+  @override
+  int get hashCode =>
+      Object.hash(threads, xnnpack, enableQS8, enableQU8, forceFP16);
+
+  @override
+  String toString() => 'TuningCandidate{$id}';
+}
+
+/// Interpreter built by [TuningCandidate.build], owning its options and
+/// delegate.
+class TunedInterpreter {
+  TunedInterpreter._(
+      this.candidate, this.interpreter, this._options, this._delegate);
+
+  /// Configuration actually used, which differs from the requested one
+  /// after a delegate fallback.
+  final TuningCandidate candidate;
+
+  final Interpreter interpreter;
+  final InterpreterOptions _options;
+  final XNNPackDelegate? _delegate;
+
+  /// Closes the interpreter, then deletes its delegate and options.
+  void close() {
+    interpreter.close();
+    _delegate?.delete();
+    _options.delete();
+  }
+}
+
+/// Timing and accuracy of one candidate measured by [Interpreter.autoTune].
+class TuningMeasurement {
+  TuningMeasurement._(this.candidate, this.medianMicros, this.maxError,
+      this.accepted, this.error);
+
+  final TuningCandidate candidate;
+
+  /// Median latency of the timed runs, or -1 if the candidate failed.
+  final int medianMicros;
+
+  /// Largest output deviation from the baseline, relative to
+  /// `max(1, |baseline|)`.
+  final double maxError;
+
+  /// Whether the outputs stayed within the tolerance.
+  final bool accepted;
+
+  /// Why the candidate could not be built or run, if it failed.
+  final String? error;
+
+  @override
+  String toString() {
+    return 'TuningMeasurement{${candidate.id}: ${medianMicros}us, maxError: $maxError, accepted: $accepted${error != null ? ', error: $error' : ''}}';
+  }
+}
+
+/// Outcome of [Interpreter.autoTune].
+class TuningResult {
+  TuningResult._(this.best, this.fromStore, this.measurements);
+
+  /// Fastest accepted configuration.
+  final TuningCandidate best;
+
+  /// Whether [best] was read from an earlier run instead of measured.
+  final bool fromStore;
+
+  /// Every candidate measured, in the order tried; empty when [fromStore].
+  final List<TuningMeasurement> measurements;
+
+  @override
+  String toString() {
+    return 'TuningResult{best: ${best.id}, fromStore: $fromStore, measured: ${measurements.length}}';
+  }
+}
+
+/// Measures interpreter configurations for a model; see
+/// [Interpreter.autoTune].
+abstract final class AutoTuner {
+  /// Identifies the processor a result was measured on: operating system,
+  /// ABI, processor count and, where `/proc/cpuinfo` is readable, the CPU
+  /// model.
+  static String cpuSignature() {
+    var model = '';
+    try {
+      final cpuinfo = File('/proc/cpuinfo');
+      if (cpuinfo.existsSync()) {
+        final names = <String>{};
+        for (final line in cpuinfo.readAsLinesSync()) {
+          final colon = line.indexOf(':');
+          if (colon < 0) {
+            continue;
+          }
+          final key = line.substring(0, colon).trim();
+          if (key == 'model name' || key == 'Hardware' || key == 'CPU part') {
+            names.add(line.substring(colon + 1).trim());
+          }
+        }
+        model = names.join('/');
+      }
+    } on FileSystemException {
+      // Not readable, e.g. sandboxed; the rest of the signature remains.
+    }
+    return '${Platform.operatingSystem}-${Abi.current()}-'
+        '${Platform.numberOfProcessors}-$model';
+  }
+
+  /// See [Interpreter.autoTune].
+  static Future<TuningResult> tune(
+    Model model, {
+    List<TuningCandidate>? candidates,
+    int warmUpRuns = 3,
+    int timedRuns = 10,
+    double tolerance = 1e-2,
+    required Directory directory,
+    String? modelKey,
+    bool forceRetune = false,
+  }) async {
+    checkArgument(timedRuns > 0, message: 'timedRuns must be positive');
+    checkArgument(warmUpRuns >= 0, message: 'warmUpRuns must not be negative');
+    final tried = candidates ?? TuningCandidate.defaults();
+    checkArgument(tried.isNotEmpty, message: 'No candidates to try');
+    final signature = cpuSignature();
+    final key = modelKey ?? await model.cacheKey;
+    final file = File(
+        p.join(directory.path, '${_hash(key)}.${_hash(signature)}.json'));
+
+    if (!forceRetune) {
+      final stored = await _read(file, signature);
+      if (stored != null && tried.contains(stored)) {
+        return TuningResult._(stored, true, const <TuningMeasurement>[]);
+      }
+    }
+
+    final baseline = TuningCandidate.baseline._build(model);
+    final List<Uint8List> inputs;
+    final List<_Output> expected;
+    try {
+      inputs = _fillSynthetic(baseline.interpreter);
+      baseline.interpreter.invoke();
+      expected = _readOutputs(baseline.interpreter);
+    } finally {
+      baseline.close();
+    }
+
+    final measurements = <TuningMeasurement>[];
+    TuningMeasurement? best;
+    for (final candidate in tried) {
+      // Let pending events through between candidates.
+      await Future<void>.delayed(Duration.zero);
+      final measurement = _measure(model, candidate, inputs, expected,
+          warmUpRuns, timedRuns, tolerance);
+      measurements.add(measurement);
+      if (measurement.accepted &&
+          (best == null || measurement.medianMicros < best.medianMicros)) {
+        best = measurement;
+      }
+    }
+    checkState(best != null,
+        message: 'No candidate ran within tolerance: $measurements');
+
+    await _write(file, signature, best!);
+    return TuningResult._(best.candidate, false, measurements);
+  }
+
+  static TuningMeasurement _measure(
+      Model model,
+      TuningCandidate candidate,
+      List<Uint8List> inputs,
+      List<_Output> expected,
+      int warmUpRuns,
+      int timedRuns,
+      double tolerance) {
+    final TunedInterpreter tuned;
+    try {
+      tuned = candidate._build(model);
+    } catch (error) {
+      return TuningMeasurement._(
+          candidate, -1, double.infinity, false, error.toString());
+    }
+    try {
+      final interpreter = tuned.interpreter;
+      final tensors = interpreter.getInputTensors();
+      for (var i = 0; i < tensors.length; i++) {
+        tensors[i].data = inputs[i];
+      }
+      for (var i = 0; i < warmUpRuns; i++) {
+        interpreter.invoke();
+      }
+      final latencies = Int64List(timedRuns);
+      final stopwatch = Stopwatch();
+      for (var i = 0; i < timedRuns; i++) {
+        stopwatch
+          ..reset()
+          ..start();
+        interpreter.invoke();
+        stopwatch.stop();
+        latencies[i] = stopwatch.elapsedMicroseconds;
+      }
+      latencies.sort();
+      final maxError = _maxError(expected, _readOutputs(interpreter));
+      return TuningMeasurement._(candidate, latencies[timedRuns ~/ 2],
+          maxError, maxError <= tolerance, null);
+    } catch (error) {
+      return TuningMeasurement._(
+          candidate, -1, double.infinity, false, error.toString());
+    } finally {
+      tuned.close();
+    }
+  }
+
+  // Fills every input with seeded pseudo-random values and returns their
+  // bytes, so each candidate sees the same inputs. Floats lie in [0, 1),
+  // 8-bit values span their range and wider integers are 0 or 1, which
+  // stays valid for index and length inputs.
+  static List<Uint8List> _fillSynthetic(Interpreter interpreter) {
+    final random = Random(42);
+    final inputs = <Uint8List>[];
+    for (final tensor in interpreter.getInputTensors()) {
+      final data = tensor.typedData;
+      switch (tensor.type) {
+        case TensorType.float32:
+        case TensorType.float64:
+          final values = data as List<double>;
+          for (var i = 0; i < values.length; i++) {
+            values[i] = random.nextDouble();
+          }
+        case TensorType.uint8:
+        case TensorType.int8:
+        case TensorType.boolean:
+          final bytes =
+              data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+          for (var i = 0; i < bytes.length; i++) {
+            bytes[i] = tensor.type == TensorType.boolean
+                ? random.nextInt(2)
+                : random.nextInt(256);
+          }
+        case TensorType.int16:
+        case TensorType.int32:
+        case TensorType.int64:
+          final values = data as List<int>;
+          for (var i = 0; i < values.length; i++) {
+            values[i] = random.nextInt(2);
+          }
+        default:
+          break;
+      }
+      inputs.add(Uint8List.fromList(
+          data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes)));
+    }
+    return inputs;
+  }
+
+  static List<_Output> _readOutputs(Interpreter interpreter) {
+    return [
+      for (final tensor in interpreter.getOutputTensors())
+        _Output.of(tensor),
+    ];
+  }
+
+  static double _maxError(List<_Output> expected, List<_Output> actual) {
+    if (expected.length != actual.length) {
+      return double.infinity;
+    }
+    var maxError = 0.0;
+    for (var i = 0; i < expected.length; i++) {
+      final a = expected[i].values;
+      final b = actual[i].values;
+      if (a.length != b.length) {
+        return double.infinity;
+      }
+      for (var n = 0; n < a.length; n++) {
+        final scale = a[n].abs() > 1 ? a[n].abs() : 1.0;
+        final error = (a[n] - b[n]).abs() / scale;
+        if (error.isNaN) {
+          return double.infinity;
+        }
+        if (error > maxError) {
+          maxError = error;
+        }
+      }
+    }
+    return maxError;
+  }
+
+  static Future<TuningCandidate?> _read(File file, String signature) async {
+    try {
+      if (!await file.exists()) {
+        return null;
+      }
+      final json =
+          jsonDecode(await file.readAsString()) as Map<String, Object?>;
+      if (json['cpu'] != signature) {
+        return null;
+      }
+      return TuningCandidate.fromJson(
+          json['candidate'] as Map<String, Object?>);
+    } catch (_) {
+      // Unreadable or from an older format: measure again.
+      return null;
+    }
+  }
+
+  // Written to a temporary name and renamed, so concurrent launches never
+  // read a partial file.
+  static Future<void> _write(
+      File file, String signature, TuningMeasurement best) async {
+    await file.parent.create(recursive: true);
+    final temp = File('${file.path}.$pid.tmp');
+    await temp.writeAsString(
+        jsonEncode({
+          'cpu': signature,
+          'candidate': best.candidate.toJson(),
+          'medianMicros': best.medianMicros,
+        }),
+        flush: true);
+    await temp.rename(file.path);
+  }
+
+  static String _hash(String value) =>
+      ModelCache.contentHash(Uint8List.fromList(utf8.encode(value)));
+}
+
+// Output values as doubles, dequantized for quantized tensors so that
+// candidates running quantized kernels compare in real units.
+class _Output {
+  _Output(this.values);
+
+  factory _Output.of(Tensor tensor) {
+    final data = tensor.typedData;
+    if (data is! List<num>) {
+      return _Output(Float64List(0));
+    }
+    final values = Float64List(data.length);
+    final params = tensor.params;
+    final quantized = tensor.type != TensorType.float32 &&
+        tensor.type != TensorType.float64 &&
+        params.scale != 0;
+    for (var i = 0; i < values.length; i++) {
+      values[i] = quantized
+          ? (data[i] - params.zeroPoint) * params.scale
+          : data[i].toDouble();
+    }
+    return _Output(values);
+  }
+
+  final Float64List values;
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart';
+import 'package:quiver/check.dart';
+
+import 'interpreter.dart';
+import 'interpreter_options.dart';
+import 'model.dart';
+import 'tensor_view.dart';
+
+/// Groups single-sample requests from concurrent callers into batched
+/// invocations of one model.
+///
+/// Requests are collected until [maxBatchSize] are pending or [maxDelay] has
+/// passed since the first one, then packed along dimension 0 of every input,
+/// run with one [Interpreter.invokeAsync] and split back along dimension 0
+/// of every output. One allocated interpreter is cached per batch size, so
+/// tensors are only allocated the first time a batch size is seen.
+///
+/// The model must take a batch of 1 along dimension 0 of every input and
+/// output, and that dimension must be resizable.
+class BatchingInterpreter {
+  BatchingInterpreter._(
+      this._model, this._createOptions, this.maxBatchSize, this.maxDelay);
+
+  /// Creates a batching front end for [model].
+  ///
+  /// Interpreters get options from [createOptions], or default options when
+  /// omitted. The batcher holds its own reference to [model], so the caller
+  /// may delete it right away.
+  static BatchingInterpreter create(
+    Model model, {
+    int maxBatchSize = 8,
+    Duration maxDelay = const Duration(milliseconds: 2),
+    InterpreterOptions Function()? createOptions,
+  }) {
+    checkArgument(maxBatchSize > 0, message: 'maxBatchSize must be positive');
+    model.retain();
+    final batcher = BatchingInterpreter._(
+        model, createOptions ?? InterpreterOptions.new, maxBatchSize, maxDelay);
+    try {
+      batcher._interpreterFor(1);
+    } catch (_) {
+      batcher.close();
+      rethrow;
+    }
+    return batcher;
+  }
+
+  final Model _model;
+  final InterpreterOptions Function() _createOptions;
+
+  /// Largest number of requests run in one invocation.
+  final int maxBatchSize;
+
+  /// Longest time the first pending request waits for others to join it.
+  final Duration maxDelay;
+
+  final Map<int, Interpreter> _interpreters = <int, Interpreter>{};
+  final List<InterpreterOptions> _options = <InterpreterOptions>[];
+  final List<_BatchRequest> _pending = <_BatchRequest>[];
+  Timer? _timer;
+  Future<void>? _running;
+  bool _closed = false;
+  int _batchCount = 0;
+  int _sampleCount = 0;
+
+  /// Number of batched invocations run so far.
+  int get batchCount => _batchCount;
+
+  /// Number of requests run so far.
+  int get sampleCount => _sampleCount;
+
+  /// Batch sizes with an allocated interpreter.
+  Iterable<int> get cachedBatchSizes => _interpreters.keys;
+
+  /// Queues one sample and returns its outputs, each with a leading
+  /// dimension of 1.
+  ///
+  /// Every input must hold exactly the bytes of one sample of the matching
+  /// model input.
+  Future<List<TensorView>> run(List<TypedData> inputs) {
+    checkState(!_closed, message: 'BatchingInterpreter already closed.');
+    final single = _interpreters[1]!;
+    checkArgument(inputs.length == single.getInputTensors().length,
+        message: 'Expected ${single.getInputTensors().length} inputs');
+    for (var i = 0; i < inputs.length; i++) {
+      single.getInputTensor(i).checkBuffer(inputs[i]);
+    }
+    final request = _BatchRequest(inputs);
+    _pending.add(request);
+    if (_pending.length >= maxBatchSize) {
+      _flush();
+    } else {
+      _timer ??= Timer(maxDelay, _flush);
+    }
+    return request.completer.future;
+  }
+
+  /// Fails pending requests, waits for the running batch and closes every
+  /// interpreter.
+  Future<void> close() async {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    _timer?.cancel();
+    _timer = null;
+    for (final request in _pending) {
+      request.completer
+          .completeError(StateError('BatchingInterpreter closed.'));
+    }
+    _pending.clear();
+    await _running;
+    for (final interpreter in _interpreters.values) {
+      interpreter.close();
+    }
+    _interpreters.clear();
+    for (final options in _options) {
+      options.delete();
+    }
+    _options.clear();
+    _model.release();
+  }
+
+  // Starts the next batch unless one is already running; batches queued
+  // meanwhile start as soon as it completes.
+  void _flush() {
+    _timer?.cancel();
+    _timer = null;
+    if (_running != null || _pending.isEmpty || _closed) {
+      return;
+    }
+    final count =
+        _pending.length < maxBatchSize ? _pending.length : maxBatchSize;
+    final batch = _pending.sublist(0, count);
+    _pending.removeRange(0, count);
+    _running = _runBatch(batch).whenComplete(() {
+      _running = null;
+      if (_pending.length >= maxBatchSize) {
+        _flush();
+      } else if (_pending.isNotEmpty) {
+        _timer ??= Timer(maxDelay, _flush);
+      }
+    });
+  }
+
+  Future<void> _runBatch(List<_BatchRequest> batch) async {
+    try {
+      final interpreter = _interpreterFor(batch.length);
+      final targets = [
+        for (final tensor in interpreter.getInputTensors()) tensor.typedData
+      ];
+      pack([for (final request in batch) request.inputs], targets);
+      await interpreter.invokeAsync();
+
+      final samples = split(
+          [for (final tensor in interpreter.getOutputTensors()) tensor.view],
+          batch.length);
+      for (var k = 0; k < batch.length; k++) {
+        batch[k].completer.complete(samples[k]);
+      }
+      _batchCount++;
+      _sampleCount += batch.length;
+    } catch (error, stackTrace) {
+      for (final request in batch) {
+        if (!request.completer.isCompleted) {
+          request.completer.completeError(error, stackTrace);
+        }
+      }
+    }
+  }
+
+  /// Packs the inputs of each sample in [samples] back to back along
+  /// dimension 0 into the batched input buffers [targets].
+  @visibleForTesting
+  static void pack(List<List<TypedData>> samples, List<TypedData> targets) {
+    for (var i = 0; i < targets.length; i++) {
+      final target = _bytesOf(targets[i]);
+      var offset = 0;
+      for (final inputs in samples) {
+        final sample = _bytesOf(inputs[i]);
+        target.setRange(offset, offset + sample.length, sample);
+        offset += sample.length;
+      }
+    }
+  }
+
+  /// Splits each batched output in [outputs] along dimension 0 into
+  /// [batchSize] copies with a leading dimension of 1, grouped by sample.
+  @visibleForTesting
+  static List<List<TensorView>> split(List<TensorView> outputs, int batchSize) {
+    return [
+      for (var k = 0; k < batchSize; k++)
+        [for (final output in outputs) output.slice(0, k, k + 1).copy()]
+    ];
+  }
+
+  // Only cached once allocated, so a batch size that fails to resize or
+  // allocate is retried by the next batch of that size.
+  Interpreter _interpreterFor(int batchSize) {
+    final cached = _interpreters[batchSize];
+    if (cached != null) {
+      return cached;
+    }
+    final options = _createOptions();
+    final Interpreter interpreter;
+    try {
+      interpreter = Interpreter.fromModel(_model, options: options);
+    } catch (_) {
+      options.delete();
+      rethrow;
+    }
+    try {
+      if (batchSize != 1) {
+        final inputs = interpreter.getInputTensors();
+        for (var i = 0; i < inputs.length; i++) {
+          final shape = List<int>.of(inputs[i].shape);
+          checkState(shape.isNotEmpty && shape[0] == 1,
+              message: 'Input $i has no batch dimension of 1: $shape');
+          shape[0] = batchSize;
+          interpreter.resizeInputTensor(i, shape);
+        }
+        interpreter.allocateTensors();
+      }
+    } catch (_) {
+      interpreter.close();
+      options.delete();
+      rethrow;
+    }
+    _options.add(options);
+    _interpreters[batchSize] = interpreter;
+    return interpreter;
+  }
+
+  static Uint8List _bytesOf(TypedData data) =>
+      data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+}
+
+class _BatchRequest {
+  _BatchRequest(this.inputs);
+
+  final List<TypedData> inputs;
+  final Completer<List<TensorView>> completer = Completer<List<TensorView>>();
+}
@@ -217,5 +217,25 @@ final DynamicLibrary _dylibGpu = () {
 /// TensorFlowLite Bindings
 final tfliteBinding = TensorFlowLiteBindings(_dylib);
 
+/// Looks up [symbol] in the TensorFlowLite library.
+///
+/// Throws [ArgumentError] if the library does not export [symbol].
+Pointer<T> tfliteLookup<T extends NativeType>(String symbol) =>
+    _dylib.lookup<T>(symbol);
+
+/// `TfLiteInterpreterGetSignatureKey`, looked up under its earlier name
+/// `TfLiteInterpreterGetSignatureName` in libraries that predate the rename,
+/// such as the bundled Linux one.
+final Pointer<Char> Function(Pointer<TfLiteInterpreter>, int)
+    tfliteGetSignatureKey = () {
+  if (_dylib.providesSymbol('TfLiteInterpreterGetSignatureKey')) {
+    return tfliteBinding.TfLiteInterpreterGetSignatureKey;
+  }
+  return _dylib.lookupFunction<
+          Pointer<Char> Function(Pointer<TfLiteInterpreter>, Int32),
+          Pointer<Char> Function(Pointer<TfLiteInterpreter>, int)>(
+      'TfLiteInterpreterGetSignatureName');
+}();
+
 /// TensorFlowLite Gpu Bindings
 final tfliteBindingGpu = TensorFlowLiteBindings(_dylibGpu);
@@ -0,0 +1,355 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter_litert/src/bindings/bindings.dart';
+import 'package:flutter_litert/src/bindings/custom_ops_library.dart';
+import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
+
+/// Maximum number of dimensions reported inline by [TfLiteFlutterTensorInfo].
+const int tfliteFlutterMaxDims = 8;
+
+/// Mirror of `TfLiteFlutterApi` in `src/runtime/tflite_flutter_runtime.h`.
+final class TfLiteFlutterApi extends Struct {
+  external Pointer<Void> interpreterGetInputTensorCount;
+  external Pointer<Void> interpreterGetInputTensor;
+  external Pointer<Void> interpreterGetOutputTensorCount;
+  external Pointer<Void> interpreterGetOutputTensor;
+  external Pointer<Void> tensorType;
+  external Pointer<Void> tensorNumDims;
+  external Pointer<Void> tensorDim;
+  external Pointer<Void> tensorByteSize;
+  external Pointer<Void> tensorData;
+  external Pointer<Void> tensorName;
+  external Pointer<Void> tensorQuantizationParams;
+  external Pointer<Void> interpreterInvoke;
+}
+
+/// Mirror of `TfLiteFlutterTensorInfo` in
+/// `src/runtime/tflite_flutter_runtime.h`.
+final class TfLiteFlutterTensorInfo extends Struct {
+  external Pointer<TfLiteTensor> tensor;
+  external Pointer<Char> name;
+  external Pointer<Void> data;
+  @Int64()
+  external int byteSize;
+  @Int32()
+  external int type;
+  @Int32()
+  external int numDims;
+  @Array(tfliteFlutterMaxDims)
+  external Array<Int32> dims;
+  @Float()
+  external double scale;
+  @Int32()
+  external int zeroPoint;
+}
+
+/// Mirror of `TfLiteFlutterRunTiming` in
+/// `src/runtime/tflite_flutter_runtime.h`.
+final class TfLiteFlutterRunTiming extends Struct {
+  @Int64()
+  external int copyInNs;
+  @Int64()
+  external int invokeNs;
+  @Int64()
+  external int copyOutNs;
+}
+
+/// Number of CPUs addressable by [TfLiteFlutterPlacement].
+const int tfliteFlutterMaxCpus = 1024;
+
+/// Bits of [TfLiteFlutterPlacement.flags].
+const int tfliteFlutterPlaceCpus = 1;
+const int tfliteFlutterPlaceNice = 2;
+const int tfliteFlutterPlacePolicy = 4;
+
+/// Mirror of `TfLiteFlutterPlacement` in
+/// `src/runtime/tflite_flutter_runtime.h`.
+final class TfLiteFlutterPlacement extends Struct {
+  @Int32()
+  external int flags;
+  @Int32()
+  external int nice;
+  @Int32()
+  external int policy;
+  @Int32()
+  external int reserved;
+  @Array(tfliteFlutterMaxCpus ~/ 64)
+  external Array<Uint64> cpus;
+}
+
+/// Opaque `TfLiteFlutterAsyncWorker` from
+/// `src/runtime/tflite_flutter_runtime.h`.
+final class TfLiteFlutterAsyncWorker extends Opaque {}
+
+/// Bindings to the runtime helpers in `src/runtime/`.
+class TfLiteFlutterRuntimeBindings {
+  TfLiteFlutterRuntimeBindings(DynamicLibrary library)
+      : setApi = library.lookupFunction<
+            Void Function(Pointer<TfLiteFlutterApi>),
+            void Function(Pointer<TfLiteFlutterApi>)>('TfLiteFlutter_SetApi'),
+        getTensorInfos = library.lookupFunction<
+            Int32 Function(
+                Pointer<TfLiteInterpreter>,
+                Pointer<TfLiteFlutterTensorInfo>,
+                Int32,
+                Pointer<TfLiteFlutterTensorInfo>,
+                Int32),
+            int Function(
+                Pointer<TfLiteInterpreter>,
+                Pointer<TfLiteFlutterTensorInfo>,
+                int,
+                Pointer<TfLiteFlutterTensorInfo>,
+                int)>('TfLiteFlutter_GetTensorInfos', isLeaf: true),
+        run = library.lookupFunction<
+            Int32 Function(
+                Pointer<TfLiteInterpreter>,
+                Pointer<Pointer<Void>>,
+                Pointer<Int64>,
+                Int32,
+                Pointer<Pointer<Void>>,
+                Pointer<Int64>,
+                Int32,
+                Pointer<TfLiteFlutterRunTiming>),
+            int Function(
+                Pointer<TfLiteInterpreter>,
+                Pointer<Pointer<Void>>,
+                Pointer<Int64>,
+                int,
+                Pointer<Pointer<Void>>,
+                Pointer<Int64>,
+                int,
+                Pointer<TfLiteFlutterRunTiming>)>('TfLiteFlutter_Run'),
+        runMany = library.lookupFunction<
+            Int32 Function(Pointer<TfLiteInterpreter>, Pointer<Void>, Int64,
+                Pointer<Void>, Int64, Int32, Pointer<Int64>, Pointer<Int32>),
+            int Function(
+                Pointer<TfLiteInterpreter>,
+                Pointer<Void>,
+                int,
+                Pointer<Void>,
+                int,
+                int,
+                Pointer<Int64>,
+                Pointer<Int32>)>('TfLiteFlutter_RunMany'),
+        prefetchFile = library.lookupFunction<
+            Int32 Function(Pointer<Char>, Int32),
+            int Function(Pointer<Char>, int)>('TfLiteFlutter_PrefetchFile'),
+        asyncWorkerCreate = library.lookupFunction<
+            Pointer<TfLiteFlutterAsyncWorker> Function(
+                Pointer<TfLiteInterpreter>, Pointer<Void>, Int64),
+            Pointer<TfLiteFlutterAsyncWorker> Function(
+                Pointer<TfLiteInterpreter>,
+                Pointer<Void>,
+                int)>('TfLiteFlutter_AsyncWorkerCreate'),
+        asyncWorkerSubmit = library.lookupFunction<
+                Int32 Function(Pointer<TfLiteFlutterAsyncWorker>, Int64),
+                int Function(Pointer<TfLiteFlutterAsyncWorker>, int)>(
+            'TfLiteFlutter_AsyncWorkerSubmit',
+            isLeaf: true),
+        asyncWorkerDelete = library.lookupFunction<
+                Void Function(Pointer<TfLiteFlutterAsyncWorker>),
+                void Function(Pointer<TfLiteFlutterAsyncWorker>)>(
+            'TfLiteFlutter_AsyncWorkerDelete'),
+        setThreadBudget =
+            library.lookupFunction<Void Function(Int32), void Function(int)>(
+                'TfLiteFlutter_SetThreadBudget',
+                isLeaf: true),
+        getThreadBudget = library.lookupFunction<Int32 Function(),
+            int Function()>('TfLiteFlutter_GetThreadBudget', isLeaf: true),
+        acquireThreads =
+            library.lookupFunction<Int32 Function(Int32), int Function(int)>(
+                'TfLiteFlutter_AcquireThreads',
+                isLeaf: true),
+        releaseThreads =
+            library.lookupFunction<Void Function(Int32), void Function(int)>(
+                'TfLiteFlutter_ReleaseThreads',
+                isLeaf: true),
+        threadsInUse = library.lookupFunction<Int32 Function(),
+            int Function()>('TfLiteFlutter_ThreadsInUse', isLeaf: true),
+        currentThreadId = library.lookupFunction<Int64 Function(),
+            int Function()>('TfLiteFlutter_CurrentThreadId', isLeaf: true),
+        listThreads = library.lookupFunction<
+            Int32 Function(Pointer<Int64>, Int32),
+            int Function(Pointer<Int64>, int)>('TfLiteFlutter_ListThreads'),
+        setThreadPlacement = library.lookupFunction<
+                Int32 Function(Int64, Pointer<TfLiteFlutterPlacement>),
+                int Function(int, Pointer<TfLiteFlutterPlacement>)>(
+            'TfLiteFlutter_SetThreadPlacement',
+            isLeaf: true),
+        getThreadPlacement = library.lookupFunction<
+                Int32 Function(Int64, Pointer<TfLiteFlutterPlacement>),
+                int Function(int, Pointer<TfLiteFlutterPlacement>)>(
+            'TfLiteFlutter_GetThreadPlacement',
+            isLeaf: true),
+        swapThreadAffinity = library.lookupFunction<
+                Int32 Function(Pointer<TfLiteFlutterPlacement>,
+                    Pointer<TfLiteFlutterPlacement>),
+                int Function(Pointer<TfLiteFlutterPlacement>,
+                    Pointer<TfLiteFlutterPlacement>)>(
+            'TfLiteFlutter_SwapThreadAffinity',
+            isLeaf: true),
+        asyncWorkerSetPlacement = library.lookupFunction<
+                Int32 Function(Pointer<TfLiteFlutterAsyncWorker>,
+                    Pointer<TfLiteFlutterPlacement>),
+                int Function(Pointer<TfLiteFlutterAsyncWorker>,
+                    Pointer<TfLiteFlutterPlacement>)>(
+            'TfLiteFlutter_AsyncWorkerSetPlacement'),
+        asyncWorkerThreadId = library.lookupFunction<
+                Int64 Function(Pointer<TfLiteFlutterAsyncWorker>),
+                int Function(Pointer<TfLiteFlutterAsyncWorker>)>(
+            'TfLiteFlutter_AsyncWorkerThreadId');
+
+  /// Installs the TFLite C API entry points used by the helpers.
+  final void Function(Pointer<TfLiteFlutterApi>) setApi;
+
+  /// Fills tensor metadata for every input and output in one call.
+  final int Function(
+      Pointer<TfLiteInterpreter> interpreter,
+      Pointer<TfLiteFlutterTensorInfo> inputs,
+      int inputCapacity,
+      Pointer<TfLiteFlutterTensorInfo> outputs,
+      int outputCapacity) getTensorInfos;
+
+  /// Copies inputs in, invokes and copies outputs out in one call.
+  final int Function(
+      Pointer<TfLiteInterpreter> interpreter,
+      Pointer<Pointer<Void>> inputs,
+      Pointer<Int64> inputSizes,
+      int inputCount,
+      Pointer<Pointer<Void>> outputs,
+      Pointer<Int64> outputSizes,
+      int outputCount,
+      Pointer<TfLiteFlutterRunTiming> timing) run;
+
+  /// Runs back-to-back inferences over packed input and output buffers.
+  final int Function(
+      Pointer<TfLiteInterpreter> interpreter,
+      Pointer<Void> inputs,
+      int inputStride,
+      Pointer<Void> outputs,
+      int outputStride,
+      int count,
+      Pointer<Int64> latencies,
+      Pointer<Int32> completed) runMany;
+
+  /// Warms the page cache for a file, or reads it through with `prefault`.
+  final int Function(Pointer<Char> path, int prefault) prefetchFile;
+
+  /// Starts a native thread running invokes of one interpreter, posting
+  /// completions with `post` (`NativeApi.postCObject`) to `port`.
+  final Pointer<TfLiteFlutterAsyncWorker> Function(
+          Pointer<TfLiteInterpreter> interpreter, Pointer<Void> post, int port)
+      asyncWorkerCreate;
+
+  /// Queues one invoke on a worker; returns 0 on success.
+  final int Function(Pointer<TfLiteFlutterAsyncWorker> worker, int jobId)
+      asyncWorkerSubmit;
+
+  /// Waits for the running invoke, drops queued ones and stops the worker.
+  final void Function(Pointer<TfLiteFlutterAsyncWorker> worker)
+      asyncWorkerDelete;
+
+  /// Sets the process-wide cap on extra compute threads.
+  final void Function(int maxThreads) setThreadBudget;
+
+  /// Returns the cap on extra compute threads, or -1 until one is set.
+  final int Function() getThreadBudget;
+
+  /// Grants between 1 and `requested` threads, the caller's included.
+  final int Function(int requested) acquireThreads;
+
+  /// Returns threads granted by [acquireThreads].
+  final void Function(int granted) releaseThreads;
+
+  /// Number of extra compute threads currently granted.
+  final int Function() threadsInUse;
+
+  /// Kernel id of the calling thread, or 0 where unsupported.
+  final int Function() currentThreadId;
+
+  /// Writes up to `capacity` thread ids of this process and returns the
+  /// total count, or -1 where unsupported.
+  final int Function(Pointer<Int64> threadIds, int capacity) listThreads;
+
+  /// Applies a placement to a thread (0 for the caller); returns 0, an
+  /// errno, or -1 where unsupported.
+  final int Function(int threadId, Pointer<TfLiteFlutterPlacement> placement)
+      setThreadPlacement;
+
+  /// Reads the placement of a thread (0 for the caller).
+  final int Function(int threadId, Pointer<TfLiteFlutterPlacement> placement)
+      getThreadPlacement;
+
+  /// Saves the caller's affinity and restricts it to a placement's CPUs.
+  final int Function(Pointer<TfLiteFlutterPlacement> placement,
+      Pointer<TfLiteFlutterPlacement> previous) swapThreadAffinity;
+
+  /// Makes a worker thread apply a placement before its next job.
+  final int Function(Pointer<TfLiteFlutterAsyncWorker> worker,
+      Pointer<TfLiteFlutterPlacement> placement) asyncWorkerSetPlacement;
+
+  /// Kernel id of a worker thread, or 0 until it has started.
+  final int Function(Pointer<TfLiteFlutterAsyncWorker> worker)
+      asyncWorkerThreadId;
+}
+
+/// Runtime helper bindings, or null when the helper library is missing or
+/// predates these symbols (callers then fall back to the plain C API).
+///
+/// The prebuilt `macos/libtflite_custom_ops.dylib` predates the helpers, so
+/// on macOS this is null unless the library is rebuilt from `src/` and
+/// bundled, or `TFLITE_CUSTOM_OPS_PATH` points at such a build. There,
+/// tensor metadata is queried per access instead of snapshotted, runs are
+/// not timed per phase, `runMany` loops in Dart, `invokeAsync` invokes
+/// synchronously, the compute thread budget is per isolate and
+/// `ModelPrefetch.willNeed` is a no-op.
+final TfLiteFlutterRuntimeBindings? runtimeBinding = () {
+  final library = loadCustomOpsLibrary();
+  if (library == null) {
+    return null;
+  }
+  try {
+    final bindings = TfLiteFlutterRuntimeBindings(library);
+    final api = calloc<TfLiteFlutterApi>();
+    api.ref
+      ..interpreterGetInputTensorCount =
+          tfliteLookup('TfLiteInterpreterGetInputTensorCount')
+      ..interpreterGetInputTensor =
+          tfliteLookup('TfLiteInterpreterGetInputTensor')
+      ..interpreterGetOutputTensorCount =
+          tfliteLookup('TfLiteInterpreterGetOutputTensorCount')
+      ..interpreterGetOutputTensor =
+          tfliteLookup('TfLiteInterpreterGetOutputTensor')
+      ..tensorType = tfliteLookup('TfLiteTensorType')
+      ..tensorNumDims = tfliteLookup('TfLiteTensorNumDims')
+      ..tensorDim = tfliteLookup('TfLiteTensorDim')
+      ..tensorByteSize = tfliteLookup('TfLiteTensorByteSize')
+      ..tensorData = tfliteLookup('TfLiteTensorData')
+      ..tensorName = tfliteLookup('TfLiteTensorName')
+      ..tensorQuantizationParams =
+          tfliteLookup('TfLiteTensorQuantizationParams')
+      ..interpreterInvoke = tfliteLookup('TfLiteInterpreterInvoke');
+    bindings.setApi(api);
+    calloc.free(api);
+    return bindings;
+  } on ArgumentError {
+    return null;
+  }
+}();
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:io';
+
+import 'package:flutter_litert/src/bindings/runtime_bindings.dart';
+
+/// Process-wide budget of compute threads shared by interpreters and
+/// XNNPack delegates.
+///
+/// Every interpreter and delegate with more than one thread starts its own
+/// thread pool, so three models with 8 threads each on an 8-core device run
+/// 24 busy threads. Clients created with [InterpreterOptions.useSharedThreads]
+/// or [XNNPackDelegate.shared] instead draw their pool threads from this
+/// budget: each one always gets its calling thread, plus extra threads only
+/// while fewer than [maxExtraThreads] are granted in total. Threads return
+/// to the budget when the options or delegate are deleted.
+///
+/// The budget lives in native code and is shared by every isolate. Without
+/// the runtime helpers, as on macOS until the bundled library is rebuilt, it
+/// is tracked per isolate.
+abstract final class ComputeThreads {
+  static int _localBudget = -1;
+  static int _localInUse = 0;
+
+  /// Maximum number of extra threads granted across all clients.
+  ///
+  /// Defaults to one less than the number of processors, leaving a core for
+  /// the calling threads.
+  static int get maxExtraThreads {
+    _ensureBudget();
+    final runtime = runtimeBinding;
+    return runtime != null ? runtime.getThreadBudget() : _localBudget;
+  }
+
+  static set maxExtraThreads(int value) {
+    if (value < 0) {
+      throw ArgumentError.value(
+          value, 'maxExtraThreads', 'must not be negative');
+    }
+    final runtime = runtimeBinding;
+    if (runtime != null) {
+      runtime.setThreadBudget(value);
+    } else {
+      _localBudget = value;
+    }
+  }
+
+  /// Number of extra threads currently granted.
+  static int get extraThreadsInUse {
+    final runtime = runtimeBinding;
+    return runtime != null ? runtime.threadsInUse() : _localInUse;
+  }
+
+  /// Grants between 1 and [requested] threads, the calling thread included.
+  ///
+  /// The result must be returned with [release].
+  static int acquire(int requested) {
+    _ensureBudget();
+    final runtime = runtimeBinding;
+    if (runtime != null) {
+      return runtime.acquireThreads(requested);
+    }
+    if (requested <= 1) {
+      return 1;
+    }
+    final available = _localBudget - _localInUse;
+    final extra = requested - 1 < available ? requested - 1 : available;
+    final granted = extra > 0 ? extra : 0;
+    _localInUse += granted;
+    return 1 + granted;
+  }
+
+  /// Returns threads granted by [acquire].
+  static void release(int granted) {
+    if (granted <= 1) {
+      return;
+    }
+    final runtime = runtimeBinding;
+    if (runtime != null) {
+      runtime.releaseThreads(granted);
+    } else {
+      _localInUse -= granted - 1;
+      if (_localInUse < 0) {
+        _localInUse = 0;
+      }
+    }
+  }
+
+  static void _ensureBudget() {
+    final runtime = runtimeBinding;
+    final budget = runtime != null ? runtime.getThreadBudget() : _localBudget;
+    if (budget < 0) {
+      final processors = Platform.numberOfProcessors;
+      maxExtraThreads = processors > 1 ? processors - 1 : 0;
+    }
+  }
+}
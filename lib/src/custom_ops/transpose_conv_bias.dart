@@ -15,9 +15,9 @@
  */
 
 import 'dart:ffi';
-import 'dart:io';
 import 'package:ffi/ffi.dart';
 import 'package:flutter_litert/src/bindings/bindings.dart';
+import 'package:flutter_litert/src/bindings/custom_ops_library.dart';
 import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
 
 /// Loads and provides access to the Convolution2DTransposeBias custom op.
@@ -45,7 +45,7 @@ class TransposeConvBiasOp {
   static void loadLibrary() {
     if (_customOpsLib != null) return;
 
-    _customOpsLib = _loadCustomOpsLibrary();
+    _customOpsLib = loadCustomOpsLibrary();
     if (_customOpsLib == null) {
       throw UnsupportedError('Failed to load custom ops library');
     }
@@ -83,132 +83,4 @@ class TransposeConvBiasOp {
 
     _isRegistered = true;
   }
-
-  /// Attempts to load the custom ops library from various locations.
-  static DynamicLibrary? _loadCustomOpsLibrary() {
-    // iOS: Custom ops are statically linked into the app via CocoaPods
-    // Use DynamicLibrary.process() to access symbols from the main executable
-    if (Platform.isIOS) {
-      try {
-        return DynamicLibrary.process();
-      } catch (e) {
-        // Fall back to DynamicLibrary.executable() if process() fails
-        try {
-          return DynamicLibrary.executable();
-        } catch (e) {
-          return null;
-        }
-      }
-    }
-
-    // Android: Custom ops are built as a separate .so via CMake
-    if (Platform.isAndroid) {
-      try {
-        return DynamicLibrary.open('libtflite_custom_ops.so');
-      } catch (e) {
-        return null;
-      }
-    }
-
-    final List<String> attemptedPaths = [];
-
-    // Desktop platforms: Check for environment variable override
-    final envPath = Platform.environment['TFLITE_CUSTOM_OPS_PATH'];
-    if (envPath != null && envPath.isNotEmpty) {
-      attemptedPaths.add('TFLITE_CUSTOM_OPS_PATH: $envPath');
-      try {
-        return DynamicLibrary.open(envPath);
-      } catch (e) {
-        // Continue to fallback paths
-      }
-    }
-
-    String libName;
-    if (Platform.isMacOS) {
-      libName = 'libtflite_custom_ops.dylib';
-    } else if (Platform.isLinux) {
-      libName = 'libtflite_custom_ops.so';
-    } else if (Platform.isWindows) {
-      libName = 'tflite_custom_ops.dll';
-    } else {
-      // Unknown platform
-      return null;
-    }
-
-    // Desktop: Try production app bundle path
-    String productionPath;
-    if (Platform.isMacOS) {
-      productionPath =
-          '${Directory(Platform.resolvedExecutable).parent.parent.path}/Resources/$libName';
-    } else if (Platform.isLinux) {
-      productionPath =
-          '${Directory(Platform.resolvedExecutable).parent.path}/lib/$libName';
-    } else {
-      productionPath =
-          '${Directory(Platform.resolvedExecutable).parent.path}/$libName';
-    }
-
-    attemptedPaths.add('Production path: $productionPath');
-    try {
-      return DynamicLibrary.open(productionPath);
-    } catch (e) {
-      // Continue to fallback paths
-    }
-
-    // macOS: Check various locations where CocoaPods puts libraries
-    if (Platform.isMacOS) {
-      final appBundle = Directory(Platform.resolvedExecutable).parent.parent;
-
-      // Check inside flutter_litert.framework/Resources
-      // This is where CocoaPods puts s.resources for framework targets
-      final frameworkResourcesPath =
-          '${appBundle.path}/Frameworks/flutter_litert.framework/Versions/A/Resources/$libName';
-      attemptedPaths.add('Framework Resources path: $frameworkResourcesPath');
-      try {
-        return DynamicLibrary.open(frameworkResourcesPath);
-      } catch (e) {
-        // Continue
-      }
-
-      // Also check without Versions/A (for symlinked frameworks)
-      final frameworkResourcesPathAlt =
-          '${appBundle.path}/Frameworks/flutter_litert.framework/Resources/$libName';
-      attemptedPaths
-          .add('Framework Resources path (alt): $frameworkResourcesPathAlt');
-      try {
-        return DynamicLibrary.open(frameworkResourcesPathAlt);
-      } catch (e) {
-        // Continue
-      }
-
-      // App's Resources directory (fallback)
-      final resourcesPath = '${appBundle.path}/Resources/$libName';
-      attemptedPaths.add('Resources path: $resourcesPath');
-      try {
-        return DynamicLibrary.open(resourcesPath);
-      } catch (e) {
-        // Continue
-      }
-
-      // Frameworks directory (fallback)
-      final frameworksPath = '${appBundle.path}/Frameworks/$libName';
-      attemptedPaths.add('Frameworks path: $frameworksPath');
-      try {
-        return DynamicLibrary.open(frameworksPath);
-      } catch (e) {
-        // Continue
-      }
-
-      final fallbackPath = '${Directory.current.path}/macos/$libName';
-      attemptedPaths.add('Fallback path: $fallbackPath');
-      try {
-        return DynamicLibrary.open(fallbackPath);
-      } catch (e) {
-        // Continue
-      }
-    }
-
-    // If we got here, library loading failed
-    return null;
-  }
 }
@@ -20,18 +20,54 @@ import 'package:quiver/check.dart';
 import 'package:flutter_litert/src/bindings/bindings.dart';
 import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
 
+import '../compute_threads.dart';
 import '../delegate.dart';
+import '../ffi/helper.dart';
 
 /// XNNPack Delegate
 class XNNPackDelegate implements Delegate {
   Pointer<TfLiteDelegate> _delegate;
   bool _deleted = false;
+  int _sharedThreads = 0;
 
   @override
   Pointer<TfLiteDelegate> get base => _delegate;
 
   XNNPackDelegate._(this._delegate);
 
+  /// Creates a delegate whose threads are drawn from the process-wide
+  /// [ComputeThreads] budget instead of adding a full private pool.
+  ///
+  /// Up to `numThreads` of [options] are granted, at least 1; see
+  /// [threads]. The threads return to the budget when the delegate is
+  /// deleted.
+  factory XNNPackDelegate.shared({XNNPackDelegateOptions? options}) {
+    final delegateOptions = options ?? XNNPackDelegateOptions();
+    final requested = delegateOptions.base.ref.num_threads;
+    final granted = ComputeThreads.acquire(requested);
+    delegateOptions.base.ref.num_threads = granted;
+    final delegate =
+        tfliteBinding.TfLiteXNNPackDelegateCreate(delegateOptions.base);
+    delegateOptions.base.ref.num_threads = requested;
+    if (options == null) {
+      delegateOptions.delete();
+    }
+    if (!isNotNull(delegate)) {
+      ComputeThreads.release(granted);
+      throw StateError('Unable to create XNNPack delegate.');
+    }
+    return XNNPackDelegate._(delegate).._sharedThreads = granted;
+  }
+
+  /// Number of threads drawn from [ComputeThreads] by
+  /// [XNNPackDelegate.shared], or 0 for other delegates.
+  int get threads => _sharedThreads;
+
+  /// Whether the delegate runs a thread pool, i.e. was created with more
+  /// than one thread.
+  bool get hasThreadPool =>
+      isNotNull(tfliteBinding.TfLiteXNNPackDelegateGetThreadPool(_delegate));
+
   factory XNNPackDelegate({XNNPackDelegateOptions? options}) {
     if (options == null) {
       return XNNPackDelegate._(
@@ -46,6 +82,63 @@ class XNNPackDelegate implements Delegate {
   void delete() {
     checkState(!_deleted, message: 'XNNPackDelegate already deleted.');
     tfliteBinding.TfLiteXNNPackDelegateDelete(_delegate);
+    ComputeThreads.release(_sharedThreads);
+    _sharedThreads = 0;
+    _deleted = true;
+  }
+}
+
+/// Packed-weights cache shared by XNNPack delegates.
+///
+/// Without a cache every delegate packs and stores its own copy of the
+/// model weights. Passing one cache to the delegates of several
+/// interpreters of the same model keeps a single packed copy, and
+/// interpreters created later skip packing.
+///
+/// Create every interpreter that should populate the cache, then call
+/// [finalizeHard] (no interpreters are added later, lowest memory) or
+/// [finalizeSoft] (more interpreters may still reuse the cached weights)
+/// before running inference. The cache must outlive every delegate using it.
+class XNNPackWeightsCache {
+  final Pointer<TfLiteXNNPackDelegateWeightsCache> _cache;
+  bool _deleted = false;
+
+  Pointer<TfLiteXNNPackDelegateWeightsCache> get base => _cache;
+
+  XNNPackWeightsCache._(this._cache);
+
+  /// Creates a cache. With [size], the cache is created holding up to
+  /// [size] bytes without growing, which avoids copies while packing.
+  factory XNNPackWeightsCache({int? size}) {
+    final cache = size == null
+        ? tfliteBinding.TfLiteXNNPackDelegateWeightsCacheCreate()
+        : tfliteBinding.TfLiteXNNPackDelegateWeightsCacheCreateWithSize(size);
+    checkState(isNotNull(cache),
+        message: 'Unable to create XNNPack weights cache.');
+    return XNNPackWeightsCache._(cache);
+  }
+
+  /// Freezes the cache, keeping room to look up weights for delegates
+  /// created afterwards.
+  void finalizeSoft() {
+    checkState(!_deleted, message: 'XNNPackWeightsCache already deleted.');
+    checkState(
+        tfliteBinding.TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(_cache),
+        message: 'Unable to finalize XNNPack weights cache.');
+  }
+
+  /// Freezes the cache and shrinks it to its contents. No delegate may be
+  /// created with it afterwards.
+  void finalizeHard() {
+    checkState(!_deleted, message: 'XNNPackWeightsCache already deleted.');
+    checkState(
+        tfliteBinding.TfLiteXNNPackDelegateWeightsCacheFinalizeHard(_cache),
+        message: 'Unable to finalize XNNPack weights cache.');
+  }
+
+  void delete() {
+    checkState(!_deleted, message: 'XNNPackWeightsCache already deleted.');
+    tfliteBinding.TfLiteXNNPackDelegateWeightsCacheDelete(_cache);
     _deleted = true;
   }
 }
@@ -59,11 +152,36 @@ class XNNPackDelegateOptions {
 
   XNNPackDelegateOptions._(this._options);
 
+  /// Flag bits of `TfLiteXNNPackDelegateOptions.flags`.
+  static const int flagQS8 = 0x00000001;
+  static const int flagQU8 = 0x00000002;
+  static const int flagForceFP16 = 0x00000004;
+  static const int flagDynamicFullyConnected = 0x00000008;
+
+  /// Creates options for [XNNPackDelegate].
+  ///
+  /// [enableQS8] and [enableQU8] run signed and unsigned 8-bit quantized
+  /// operators in XNNPack, [forceFP16] computes float operators in half
+  /// precision where supported, and [dynamicFullyConnected] accelerates
+  /// fully connected operators with dynamic weights. Delegates of several
+  /// interpreters may share one [weightsCache].
   factory XNNPackDelegateOptions({
     int numThreads = 1,
+    bool enableQS8 = false,
+    bool enableQU8 = false,
+    bool forceFP16 = false,
+    bool dynamicFullyConnected = false,
+    XNNPackWeightsCache? weightsCache,
   }) {
     final options = calloc<TfLiteXNNPackDelegateOptions>();
     options.ref.num_threads = numThreads;
+    options.ref.flags = (enableQS8 ? flagQS8 : 0) |
+        (enableQU8 ? flagQU8 : 0) |
+        (forceFP16 ? flagForceFP16 : 0) |
+        (dynamicFullyConnected ? flagDynamicFullyConnected : 0);
+    if (weightsCache != null) {
+      options.ref.weights_cache = weightsCache.base;
+    }
 
     return XNNPackDelegateOptions._(options);
   }
@@ -14,23 +14,33 @@
  * limitations under the License.
  */
 
+import 'dart:async';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:flutter/services.dart';
 import 'package:quiver/check.dart';
 import 'package:flutter_litert/src/bindings/bindings.dart';
+import 'package:flutter_litert/src/bindings/runtime_bindings.dart';
 import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
 
+import 'auto_tune.dart';
 import 'ffi/helper.dart';
 import 'interpreter_options.dart';
 import 'model.dart';
+import 'model_cache.dart';
+import 'native_buffer.dart';
+import 'signature_runner.dart';
 import 'tensor.dart';
+import 'thread_placement.dart';
 
 /// TensorFlowLite interpreter for running inference on a model.
 class Interpreter {
   final Pointer<TfLiteInterpreter> _interpreter;
+  Model? _model;
   bool _deleted = false;
   bool _allocated = false;
   int _lastNativeInferenceDurationMicroSeconds = 0;
@@ -41,10 +51,67 @@ class Interpreter {
   int? _inputTensorsCount;
   int? _outputTensorsCount;
 
+  Map<String, int>? _inputIndexByName;
+  Map<String, int>? _outputIndexByName;
+
+  // Bumped whenever tensor memory may move, so prepared [RunPlan]s can tell
+  // their cached views are stale.
+  int _generation = 0;
+
+  // Whether tensor metadata may be cached from a native snapshot. Disabled
+  // for interpreters adopted with [Interpreter.fromAddress], which another
+  // isolate may resize behind our back.
+  bool _cacheMetadata = true;
+  bool _metadataValid = false;
+
+  // Whether invoke may reshape or move an output, so its cached metadata has
+  // to be dropped after every run. Checked right after allocation, before
+  // an invoke gives outputs of dynamically shaped ops their buffers.
+  bool _dynamicOutputs = true;
+
+  final Map<int, TypedData> _outputBindings = <int, TypedData>{};
+
+  final Map<String, SignatureRunner> _signatureRunners =
+      <String, SignatureRunner>{};
+
+  _NativeRunArgs? _runArgs;
+  final _StagingBuffer _manyInputs = _StagingBuffer();
+  final _StagingBuffer _manyOutputs = _StagingBuffer();
+  final _StagingBuffer _manyLatencies = _StagingBuffer();
+  RunTiming? _lastRunTiming;
+  InterpreterLoadTimings? _loadTimings;
+
+  // Native thread and port used by [invokeAsync], created on first use.
+  Pointer<TfLiteFlutterAsyncWorker>? _asyncWorker;
+  RawReceivePort? _asyncPort;
+  final Map<int, Completer<void>> _asyncInvokes = <int, Completer<void>>{};
+
+  // Placement from [InterpreterOptions.placement], and the status of each
+  // thread placed with it.
+  final ThreadPlacer? _placer;
+  final Map<int, int> _placedThreads = <int, int>{};
+  bool _placedAfterInvoke = false;
+  int _nextAsyncInvokeId = 0;
+
   int get lastNativeInferenceDurationMicroSeconds =>
       _lastNativeInferenceDurationMicroSeconds;
 
-  Interpreter._(this._interpreter, {bool skipAllocate = false}) {
+  /// Per-phase timing of the last [runForMultipleInputs] call that went
+  /// through the native run path, or null if none did.
+  RunTiming? get lastRunTiming => _lastRunTiming;
+
+  /// Per-phase timing of [load] or [loadFile], or null if the interpreter
+  /// was created otherwise.
+  InterpreterLoadTimings? get loadTimings => _loadTimings;
+
+  Interpreter._(this._interpreter,
+      {bool skipAllocate = false,
+      ThreadPlacer? placer,
+      Map<int, int>? placedThreads})
+      : _placer = placer {
+    if (placedThreads != null) {
+      _placedThreads.addAll(placedThreads);
+    }
     if (!skipAllocate) {
       allocateTensors();
     }
@@ -54,11 +121,49 @@ class Interpreter {
   ///
   /// Throws [ArgumentError] is unsuccessful.
   factory Interpreter._create(Model model, {InterpreterOptions? options}) {
-    final interpreter = tfliteBinding.TfLiteInterpreterCreate(
-        model.base, options?.base ?? cast<TfLiteInterpreterOptions>(nullptr));
+    final placer = options?.placer;
+    final placed = <int, int>{};
+    Pointer<TfLiteInterpreter> create() =>
+        tfliteBinding.TfLiteInterpreterCreate(model.base,
+            options?.base ?? cast<TfLiteInterpreterOptions>(nullptr));
+    final interpreter = placer == null
+        ? create()
+        : placer.placeThreadsStartedBy(create, placed);
     checkArgument(isNotNull(interpreter),
         message: 'Unable to create interpreter.');
-    return Interpreter._(interpreter);
+    model.retain();
+    try {
+      return Interpreter._(interpreter,
+          placer: placer, placedThreads: placed)
+        .._model = model;
+    } catch (_) {
+      tfliteBinding.TfLiteInterpreterDelete(interpreter);
+      model.release();
+      rethrow;
+    }
+  }
+
+  /// Creates an interpreter from a loaded [model].
+  ///
+  /// The interpreter shares the model's read-only weights rather than
+  /// parsing and copying them again, so a pool of interpreters for one
+  /// network only adds one set of activation buffers per interpreter. The
+  /// model stays alive until it is deleted and every interpreter created
+  /// from it is closed.
+  ///
+  /// Throws [ArgumentError] if unsuccessful.
+  ///
+  /// Example:
+  ///
+  /// ```dart
+  /// final model = Model.fromFile(path);
+  /// final interpreters =
+  ///     List.generate(4, (_) => Interpreter.fromModel(model));
+  /// model.delete(); // freed once all four interpreters are closed
+  /// ```
+  factory Interpreter.fromModel(Model model, {InterpreterOptions? options}) {
+    checkArgument(!model.isDeleted, message: 'Model already deleted.');
+    return Interpreter._create(model, options: options);
   }
 
   /// Creates [Interpreter] from a model file
@@ -83,9 +188,11 @@ class Interpreter {
   /// ```
   factory Interpreter.fromFile(File modelFile, {InterpreterOptions? options}) {
     final model = Model.fromFile(modelFile.path);
-    final interpreter = Interpreter._create(model, options: options);
-    model.delete();
-    return interpreter;
+    try {
+      return Interpreter._create(model, options: options);
+    } finally {
+      model.delete();
+    }
   }
 
   /// Creates interpreter from a [buffer]
@@ -107,9 +214,11 @@ class Interpreter {
   factory Interpreter.fromBuffer(Uint8List buffer,
       {InterpreterOptions? options}) {
     final model = Model.fromBuffer(buffer);
-    final interpreter = Interpreter._create(model, options: options);
-    model.delete();
-    return interpreter;
+    try {
+      return Interpreter._create(model, options: options);
+    } finally {
+      model.delete();
+    }
   }
 
   /// Creates interpreter from a [assetName]
@@ -127,6 +236,210 @@ class Interpreter {
     return Interpreter.fromBuffer(buffer, options: options);
   }
 
+  /// Creates interpreter from [assetName] through the on-disk [ModelCache].
+  ///
+  /// The asset is extracted once into [cache] (by default
+  /// [ModelCache.defaultCache]) and memory-mapped from there, so unlike
+  /// [fromAsset] the model is never held on the Dart or native heap. Without
+  /// a [cacheKey], every call still loads the whole asset and hashes it on a
+  /// background isolate to find its cached file; a stable [cacheKey] that
+  /// changes with the asset, such as the app build number, is needed to skip
+  /// reading the asset on later launches. [prefetch] warms the mapped file
+  /// before the interpreter is created.
+  ///
+  /// Assets named as compressed (see [ModelCache.isCompressedAssetName]) are
+  /// decompressed into the cache on a background isolate first, reporting
+  /// to [onDecompressed].
+  ///
+  /// Example:
+  ///
+  /// ```dart
+  /// final interpreter = await Interpreter.fromCachedAsset(
+  ///     'assets/your_model.tflite',
+  ///     prefetch: ModelPrefetch.willNeed);
+  /// ```
+  static Future<Interpreter> fromCachedAsset(String assetName,
+      {InterpreterOptions? options,
+      String? cacheKey,
+      ModelPrefetch prefetch = ModelPrefetch.none,
+      ModelCache? cache,
+      void Function(DecompressionStats stats)? onDecompressed}) async {
+    final modelCache = cache ?? ModelCache.defaultCache;
+    final model = ModelCache.isCompressedAssetName(assetName)
+        ? await modelCache.loadCompressedAsset(assetName,
+            cacheKey: cacheKey,
+            prefetch: prefetch,
+            onDecompressed: onDecompressed)
+        : await modelCache.loadAsset(assetName,
+            cacheKey: cacheKey, prefetch: prefetch);
+    try {
+      return Interpreter.fromModel(model, options: options);
+    } finally {
+      model.delete();
+    }
+  }
+
+  /// Loads [assetName] and creates a ready-to-run interpreter without
+  /// blocking the calling isolate.
+  ///
+  /// The asset is extracted into [cache] as by [fromCachedAsset]. Model
+  /// loading, interpreter creation, tensor allocation and [warmUpRuns]
+  /// invocations on zero-filled inputs then run on a background isolate, so
+  /// one-off costs such as XNNPACK weight packing are paid before the first
+  /// real inference. Per-phase timings are available from [loadTimings].
+  ///
+  /// [options] must stay alive until the returned interpreter is closed.
+  /// Delegates bound to the creating thread, such as the GPU delegate on
+  /// some platforms, should be used with [warmUpRuns] set to 0.
+  static Future<Interpreter> load(String assetName,
+      {InterpreterOptions? options,
+      int warmUpRuns = 1,
+      String? cacheKey,
+      ModelCache? cache}) async {
+    final stopwatch = Stopwatch()..start();
+    final modelCache = cache ?? ModelCache.defaultCache;
+    final file = ModelCache.isCompressedAssetName(assetName)
+        ? await modelCache.extractCompressedAsset(assetName, cacheKey: cacheKey)
+        : await modelCache.extractAsset(assetName, cacheKey: cacheKey);
+    return _load(file.path, options, warmUpRuns, stopwatch.elapsedMicroseconds);
+  }
+
+  /// Same as [load] for a model file on disk.
+  static Future<Interpreter> loadFile(File modelFile,
+      {InterpreterOptions? options, int warmUpRuns = 1}) {
+    return _load(modelFile.path, options, warmUpRuns, 0);
+  }
+
+  /// Measures [candidates] (by default [TuningCandidate.defaults]) on
+  /// [model] and returns the fastest one whose outputs stay within
+  /// [tolerance] of the single-threaded fp32 CPU baseline.
+  ///
+  /// Every candidate is built with its own [InterpreterOptions] and runs
+  /// [warmUpRuns] then [timedRuns] invocations on the same seeded synthetic
+  /// inputs; it is ranked by median latency. Deviation is measured relative
+  /// to `max(1, |baseline|)` on dequantized outputs. Candidates whose
+  /// delegate cannot be created or applied are skipped.
+  ///
+  /// The winner is stored in [directory] under [modelKey], by default
+  /// [Model.cacheKey], and [AutoTuner.cpuSignature]. Later launches on the
+  /// same device return it right away with [TuningResult.fromStore] set,
+  /// unless [forceRetune]. Pass a directory the OS does not purge, such as
+  /// the app's application-support directory; a temporary directory may be
+  /// cleared between launches and force measuring again.
+  /// Measuring blocks the calling isolate while each candidate runs. Build
+  /// the chosen interpreter with [TuningCandidate.build].
+  static Future<TuningResult> autoTune(Model model,
+      {List<TuningCandidate>? candidates,
+      int warmUpRuns = 3,
+      int timedRuns = 10,
+      double tolerance = 1e-2,
+      required Directory directory,
+      String? modelKey,
+      bool forceRetune = false}) {
+    return AutoTuner.tune(model,
+        candidates: candidates,
+        warmUpRuns: warmUpRuns,
+        timedRuns: timedRuns,
+        tolerance: tolerance,
+        directory: directory,
+        modelKey: modelKey,
+        forceRetune: forceRetune);
+  }
+
+  static Future<Interpreter> _load(String path, InterpreterOptions? options,
+      int warmUpRuns, int extractMicroseconds) async {
+    checkArgument(warmUpRuns >= 0, message: 'warmUpRuns must not be negative');
+    final optionsAddress = options?.base.address ?? 0;
+    final placer = options?.placer;
+    final placementAddress = placer?.base.address ?? 0;
+    final result = await Isolate.run(() => _createInBackground(
+        path, optionsAddress, placementAddress, warmUpRuns));
+    final pointer = Pointer<TfLiteInterpreter>.fromAddress(result[0]);
+    final placed = <int, int>{
+      for (var i = 6; i + 1 < result.length; i += 2) result[i]: result[i + 1]
+    };
+    return Interpreter._(pointer,
+        skipAllocate: true, placer: placer, placedThreads: placed)
+      .._allocated = true
+      .._dynamicOutputs = result[5] != 0
+      .._placedAfterInvoke = warmUpRuns > 0
+      .._loadTimings = InterpreterLoadTimings._(extractMicroseconds,
+          result[1], result[2], result[3], result[4], warmUpRuns);
+  }
+
+  /// Runs on the background isolate of [_load]. Returns the interpreter
+  /// address, the model load, create, allocate and warm-up times, 1 if
+  /// outputs are dynamic and 0 otherwise, and then the id and status of
+  /// each thread placed with the placement at [placementAddress].
+  static List<int> _createInBackground(String path, int optionsAddress,
+      int placementAddress, int warmUpRuns) {
+    final placement =
+        Pointer<TfLiteFlutterPlacement>.fromAddress(placementAddress);
+    final placed = <int, int>{};
+    T placing<T>(T Function() call) =>
+        ThreadPlacer.placeStartedBy(placement, call, placed);
+
+    final stopwatch = Stopwatch()..start();
+    final model = Model.fromFile(path);
+    final modelMicros = stopwatch.elapsedMicroseconds;
+
+    // The interpreter keeps its own reference to the mapped model.
+    final options =
+        Pointer<TfLiteInterpreterOptions>.fromAddress(optionsAddress);
+    final interpreter = placing(
+        () => tfliteBinding.TfLiteInterpreterCreate(model.base, options));
+    model.delete();
+    checkArgument(isNotNull(interpreter),
+        message: 'Unable to create interpreter.');
+    final createMicros = stopwatch.elapsedMicroseconds;
+
+    try {
+      checkState(placing(() =>
+              tfliteBinding.TfLiteInterpreterAllocateTensors(interpreter)) ==
+          TfLiteStatus.kTfLiteOk);
+      final allocateMicros = stopwatch.elapsedMicroseconds;
+      final dynamicOutputs = Tensor.anyDynamic(List.generate(
+          tfliteBinding.TfLiteInterpreterGetOutputTensorCount(interpreter),
+          (i) => Tensor(
+              tfliteBinding.TfLiteInterpreterGetOutputTensor(interpreter, i))));
+
+      if (warmUpRuns > 0) {
+        final count =
+            tfliteBinding.TfLiteInterpreterGetInputTensorCount(interpreter);
+        for (var i = 0; i < count; i++) {
+          final tensor =
+              tfliteBinding.TfLiteInterpreterGetInputTensor(interpreter, i);
+          final data = tfliteBinding.TfLiteTensorData(tensor);
+          final size = tfliteBinding.TfLiteTensorByteSize(tensor);
+          if (isNotNull(data)) {
+            data.cast<Uint8>().asTypedList(size).fillRange(0, size, 0);
+          }
+        }
+        checkState(placing(
+                () => tfliteBinding.TfLiteInterpreterInvoke(interpreter)) ==
+            TfLiteStatus.kTfLiteOk);
+        for (var i = 1; i < warmUpRuns; i++) {
+          checkState(tfliteBinding.TfLiteInterpreterInvoke(interpreter) ==
+              TfLiteStatus.kTfLiteOk);
+        }
+      }
+      final warmUpMicros = stopwatch.elapsedMicroseconds;
+
+      return [
+        interpreter.address,
+        modelMicros,
+        createMicros - modelMicros,
+        allocateMicros - createMicros,
+        warmUpMicros - allocateMicros,
+        dynamicOutputs ? 1 : 0,
+        for (final entry in placed.entries) ...[entry.key, entry.value],
+      ];
+    } catch (_) {
+      tfliteBinding.TfLiteInterpreterDelete(interpreter);
+      rethrow;
+    }
+  }
+
   /// Get byte buffer
   static Future<Uint8List> _getBuffer(String assetFileName) async {
     ByteData rawAssetFile = await rootBundle.load(assetFileName);
@@ -146,28 +459,195 @@ class Interpreter {
     final interpreter = Pointer<TfLiteInterpreter>.fromAddress(address);
     return Interpreter._(interpreter, skipAllocate: allocated)
       .._deleted = deleted
-      .._allocated = allocated;
+      .._allocated = allocated
+      .._cacheMetadata = false;
   }
 
   /// Destroys the interpreter instance.
   void close() {
     checkState(!_deleted, message: 'Interpreter already deleted.');
+    _closeAsyncWorker();
+    for (final runner in _signatureRunners.values) {
+      runner.delete();
+    }
+    _signatureRunners.clear();
     tfliteBinding.TfLiteInterpreterDelete(_interpreter);
+    _model?.release();
+    _model = null;
+    _runArgs?.free();
+    _runArgs = null;
+    _manyInputs.free();
+    _manyOutputs.free();
+    _manyLatencies.free();
     _deleted = true;
+    _generation++;
+    _invalidateMetadata();
   }
 
   /// Updates allocations for all tensors.
   void allocateTensors() {
-    checkState(tfliteBinding.TfLiteInterpreterAllocateTensors(_interpreter) ==
+    _checkNoAsyncInvoke();
+    checkState(_placingThreads(() =>
+            tfliteBinding.TfLiteInterpreterAllocateTensors(_interpreter)) ==
         TfLiteStatus.kTfLiteOk);
     _allocated = true;
+    _generation++;
+    _invalidateMetadata();
+    _dynamicOutputs =
+        Tensor.anyDynamic(_outputTensors ??= _createOutputTensors());
   }
 
   /// Runs inference for the loaded graph.
   void invoke() {
     checkState(_allocated, message: 'Interpreter not allocated.');
-    checkState(tfliteBinding.TfLiteInterpreterInvoke(_interpreter) ==
-        TfLiteStatus.kTfLiteOk);
+    _checkNoAsyncInvoke();
+    final status =
+        _placed(() => tfliteBinding.TfLiteInterpreterInvoke(_interpreter));
+    checkState(status == TfLiteStatus.kTfLiteOk);
+    _didInvoke();
+  }
+
+  /// Runs inference on a native thread and completes when it is done.
+  ///
+  /// No isolate is blocked or spawned: each interpreter owns one native
+  /// worker thread that runs queued calls in order and posts completion to
+  /// this isolate's event loop. Set the inputs before calling and leave the
+  /// tensors alone until the returned future completes; [invoke],
+  /// [allocateTensors] and [resizeInputTensor] throw meanwhile.
+  ///
+  /// Falls back to a synchronous [invoke] when the runtime helpers are not
+  /// available on this platform, which includes macOS until its bundled
+  /// helper library is rebuilt from `src/`.
+  Future<void> invokeAsync() {
+    checkState(!_deleted, message: 'Interpreter already deleted.');
+    checkState(_allocated, message: 'Interpreter not allocated.');
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      return Future.sync(invoke);
+    }
+    final worker = _asyncWorker ?? _startAsyncWorker(runtime);
+    final id = _nextAsyncInvokeId++;
+    checkState(runtime.asyncWorkerSubmit(worker, id) == 0,
+        message: 'Unable to queue an async invoke.');
+    final completer = Completer<void>();
+    _asyncInvokes[id] = completer;
+    return completer.future;
+  }
+
+  /// Whether [invokeAsync] calls are still running or queued.
+  bool get hasPendingAsyncInvokes => _asyncInvokes.isNotEmpty;
+
+  Pointer<TfLiteFlutterAsyncWorker> _startAsyncWorker(
+      TfLiteFlutterRuntimeBindings runtime) {
+    final port = RawReceivePort(_onAsyncInvokeDone, 'Interpreter.invokeAsync');
+    final post = NativeApi.postCObject.cast<Void>();
+    final worker =
+        runtime.asyncWorkerCreate(_interpreter, post, port.sendPort.nativePort);
+    if (!isNotNull(worker)) {
+      port.close();
+      throw StateError('Unable to start the async invoke thread.');
+    }
+    final placer = _placer;
+    // Thread pools the worker starts inherit its placement, so async
+    // invocations need no snapshot of their own.
+    if (placer != null && isNotNull(placer.base)) {
+      runtime.asyncWorkerSetPlacement(worker, placer.base);
+    }
+    _asyncPort = port;
+    return _asyncWorker = worker;
+  }
+
+  // Messages are `(id << 8) | status`, see TfLiteFlutter_AsyncWorkerSubmit.
+  void _onAsyncInvokeDone(Object? message) {
+    final value = message as int;
+    final completer = _asyncInvokes.remove(value >> 8);
+    if (completer == null) {
+      return;
+    }
+    _didInvoke();
+    if ((value & 0xff) == TfLiteStatus.kTfLiteOk) {
+      completer.complete();
+    } else {
+      completer.completeError(StateError('Unable to invoke the interpreter.'));
+    }
+  }
+
+  void _checkNoAsyncInvoke() {
+    checkState(_asyncInvokes.isEmpty,
+        message: 'Interpreter has pending invokeAsync calls.');
+  }
+
+  // Waits for a running async invoke, so the interpreter is never deleted
+  // under it, and fails the ones still queued.
+  void _closeAsyncWorker() {
+    final worker = _asyncWorker;
+    if (worker != null) {
+      runtimeBinding!.asyncWorkerDelete(worker);
+      _asyncWorker = null;
+    }
+    _asyncPort?.close();
+    _asyncPort = null;
+    for (final completer in _asyncInvokes.values) {
+      completer.completeError(StateError('Interpreter closed.'));
+    }
+    _asyncInvokes.clear();
+  }
+
+  void _didInvoke() {
+    // Only dynamic outputs are reshaped or reallocated by invoke; the rest
+    // keep what they got from allocateTensors.
+    if (_metadataValid && _dynamicOutputs) {
+      Tensor.clearMetadata(_outputTensors ?? const []);
+      _metadataValid = false;
+    }
+  }
+
+  /// Threads placed with [InterpreterOptions.placement], with the
+  /// placement the kernel reports for each; empty without a placement or
+  /// where placement is unsupported.
+  ///
+  /// Covers thread pools started by delegates and the interpreter, and the
+  /// [invokeAsync] thread.
+  List<PlacedThread> get threadPlacement {
+    final threads = <int, int>{
+      ...?_placer?.delegateThreads,
+      ..._placedThreads,
+    };
+    final worker = _asyncWorker;
+    if (worker != null && _placer != null) {
+      final id = runtimeBinding!.asyncWorkerThreadId(worker);
+      if (id != 0) {
+        threads.putIfAbsent(id, () => 0);
+      }
+    }
+    return [
+      for (final entry in threads.entries)
+        PlacedThread(
+            entry.key, entry.value, ThreadPlacement.ofThread(entry.key)),
+    ];
+  }
+
+  // Runs a native call that may start thread pools, placing the threads
+  // that appear while it runs.
+  T _placingThreads<T>(T Function() call) {
+    final placer = _placer;
+    return placer == null
+        ? call()
+        : placer.placeThreadsStartedBy(call, _placedThreads);
+  }
+
+  // Runs an invocation on the calling thread restricted to the placement's
+  // CPUs. CPU thread pools may only start on the first invocation.
+  T _placed<T>(T Function() body) {
+    final placer = _placer;
+    if (placer == null) {
+      return body();
+    }
+    if (_placedAfterInvoke) {
+      return placer.run(body);
+    }
+    _placedAfterInvoke = true;
+    return _placingThreads(() => placer.run(body));
   }
 
   /// Run for single input and output
@@ -178,18 +658,230 @@ class Interpreter {
   }
 
   /// Run for multiple inputs and outputs
+  ///
+  /// Only the output indexes present in [outputs] are copied; other outputs
+  /// are left untouched in tensor memory.
+  ///
+  /// When every input and output is a [NativeBuffer], copy-in, invoke and
+  /// copy-out happen in a single native call, timed per phase in
+  /// [lastRunTiming]. That needs the runtime helpers, which the bundled
+  /// macOS library does not have yet; there [lastRunTiming] stays null.
   void runForMultipleInputs(List<Object> inputs, Map<int, Object> outputs) {
+    _checkNoAsyncInvoke();
     if (outputs.isEmpty) {
       throw ArgumentError('Input error: Outputs should not be null or empty.');
     }
+    if (_runNative(inputs, outputs)) {
+      return;
+    }
     runInference(inputs);
-    var outputTensors = getOutputTensors();
-    for (var i = 0; i < outputTensors.length; i++) {
-      outputTensors[i].copyTo(outputs[i]!);
+    for (final entry in outputs.entries) {
+      getOutputTensor(entry.key).copyTo(entry.value);
+    }
+  }
+
+  bool _runNative(List<Object> inputs, Map<int, Object> outputs) {
+    final runtime = runtimeBinding;
+    if (runtime == null || !_allocated || _deleted || inputs.isEmpty) {
+      return false;
+    }
+    final inputTensors = getInputTensors();
+    final outputTensors = getOutputTensors();
+    if (inputs.length > inputTensors.length) {
+      return false;
+    }
+    for (final input in inputs) {
+      if (input is! TypedData || NativeBuffer.addressOf(input) == null) {
+        return false;
+      }
+    }
+    var outputCount = 0;
+    for (final entry in outputs.entries) {
+      final output = entry.value;
+      if (output is! TypedData ||
+          NativeBuffer.addressOf(output) == null ||
+          entry.key < 0 ||
+          entry.key >= outputTensors.length) {
+        return false;
+      }
+      if (entry.key >= outputCount) {
+        outputCount = entry.key + 1;
+      }
+    }
+
+    final args = _runArgs ??=
+        _NativeRunArgs(inputTensors.length, outputTensors.length);
+    for (var i = 0; i < inputs.length; i++) {
+      final input = inputs[i] as TypedData;
+      inputTensors[i].checkBuffer(input);
+      args.inputs[i] = NativeBuffer.addressOf(input)!;
+      args.inputSizes[i] = input.lengthInBytes;
+    }
+    for (var i = 0; i < outputCount; i++) {
+      args.outputs[i] = nullptr;
+    }
+    for (final entry in outputs.entries) {
+      final output = entry.value as TypedData;
+      outputTensors[entry.key].checkBuffer(output);
+      args.outputs[entry.key] = NativeBuffer.addressOf(output)!;
+      args.outputSizes[entry.key] = output.lengthInBytes;
+    }
+
+    final timingPtr = args.timing;
+    final status = _placed(() => runtime.run(
+        _interpreter,
+        args.inputs,
+        args.inputSizes,
+        inputs.length,
+        args.outputs,
+        args.outputSizes,
+        outputCount,
+        timingPtr));
+    _didInvoke();
+    checkState(status == TfLiteStatus.kTfLiteOk, message: 'Native run failed.');
+
+    final timing = timingPtr.ref;
+    _lastRunTiming =
+        RunTiming._(timing.copyInNs, timing.invokeNs, timing.copyOutNs);
+    _lastNativeInferenceDurationMicroSeconds = timing.invokeNs ~/ 1000;
+
+    for (final entry in _outputBindings.entries) {
+      if (!outputs.containsKey(entry.key)) {
+        getOutputTensor(entry.key).copyTo(entry.value);
+      }
     }
+    return true;
+  }
+
+  /// Runs [count] inferences back to back over packed buffers.
+  ///
+  /// Call i reads input tensor 0 from the i-th slice of [inputs] and writes
+  /// output tensor 0 to the i-th slice of [outputs], each slice being one
+  /// tensor's worth of elements. The whole loop runs natively in one FFI
+  /// call, so this suits many tiny inferences where the per-call overhead of
+  /// [run] dominates. Buffers that are not [NativeBuffer]s are staged through
+  /// native memory with one copy per batch. Without the runtime helpers (on
+  /// macOS, for now) the same loop runs in Dart, one [invoke] per call.
+  ///
+  /// Throws [ArgumentError] if the buffers do not hold [count] slices, and
+  /// [StateError] if an invocation fails.
+  RunManyStats runMany(Float32List inputs, Float32List outputs, int count) {
+    checkState(!_deleted, message: 'Interpreter already deleted.');
+    _checkNoAsyncInvoke();
+    if (!_allocated) {
+      allocateTensors();
+    }
+    final input = getInputTensor(0);
+    final output = getOutputTensor(0);
+    final isFloat32 =
+        input.type == TensorType.float32 && output.type == TensorType.float32;
+    checkArgument(isFloat32,
+        message: 'runMany requires float32 input and output tensors');
+    checkArgument(count >= 0, message: 'count must not be negative');
+    final inputStride = input.numBytes();
+    final outputStride = output.numBytes();
+    checkArgument(inputs.lengthInBytes == count * inputStride,
+        message:
+            'Inputs of ${inputs.lengthInBytes} bytes do not hold $count inputs of $inputStride bytes');
+    checkArgument(outputs.lengthInBytes == count * outputStride,
+        message:
+            'Outputs of ${outputs.lengthInBytes} bytes do not hold $count outputs of $outputStride bytes');
+    if (count == 0) {
+      return RunManyStats._(Int64List(0));
+    }
+
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      return _runManyInDart(inputs, outputs, count);
+    }
+
+    final inputBytes = _bytesOf(inputs);
+    final outputBytes = _bytesOf(outputs);
+    var inputPtr = NativeBuffer.addressOf(inputs);
+    if (inputPtr == null) {
+      final staged = _manyInputs.reserve(inputBytes.length);
+      staged.asTypedList(inputBytes.length).setAll(0, inputBytes);
+      inputPtr = staged.cast();
+    }
+    final nativeOutputPtr = NativeBuffer.addressOf(outputs);
+    final outputPtr =
+        nativeOutputPtr ?? _manyOutputs.reserve(outputBytes.length).cast();
+    final latencies = _manyLatencies.reserve(count * 8 + 4);
+    final completed = (latencies + count * 8).cast<Int32>();
+
+    final status = _placed(() => runtime.runMany(_interpreter, inputPtr,
+        inputStride, outputPtr, outputStride, count, latencies.cast(),
+        completed));
+    _didInvoke();
+    final done = completed.value;
+    if (nativeOutputPtr == null) {
+      final staged = outputPtr.cast<Uint8>().asTypedList(done * outputStride);
+      outputBytes.setAll(0, staged);
+    }
+    checkState(status == TfLiteStatus.kTfLiteOk,
+        message: 'runMany failed after $done of $count invocations.');
+    final stats = RunManyStats._(
+        Int64List.fromList(latencies.cast<Int64>().asTypedList(count)));
+    _lastNativeInferenceDurationMicroSeconds = stats.meanNanos ~/ 1000;
+    return stats;
+  }
+
+  RunManyStats _runManyInDart(
+      Float32List inputs, Float32List outputs, int count) {
+    final input = getInputTensor(0).typedData as Float32List;
+    final inputLength = input.length;
+    final latencies = Int64List(count);
+    final stopwatch = Stopwatch();
+    for (var i = 0; i < count; i++) {
+      stopwatch
+        ..reset()
+        ..start();
+      input.setRange(0, inputLength, inputs, i * inputLength);
+      invoke();
+      final output = getOutputTensor(0).typedData as Float32List;
+      outputs.setRange(i * output.length, (i + 1) * output.length, output);
+      stopwatch.stop();
+      latencies[i] = stopwatch.elapsedMicroseconds * 1000;
+    }
+    final stats = RunManyStats._(latencies);
+    _lastNativeInferenceDurationMicroSeconds = stats.meanNanos ~/ 1000;
+    return stats;
+  }
+
+  /// Binds [buffer] to the output tensor at [index].
+  ///
+  /// After every subsequent inference the output is copied into [buffer] with
+  /// a single memcpy, so callers can register their buffers once and read
+  /// them after each [run], [runForMultipleInputs] or [runInference] call.
+  /// Outputs without a binding are never copied by [runInference].
+  ///
+  /// Throws [ArgumentError] if [index] is invalid or [buffer] does not match
+  /// the current size of the output tensor.
+  void bindOutput(int index, TypedData buffer) {
+    final tensor = getOutputTensor(index);
+    if (_allocated) {
+      checkArgument(buffer.lengthInBytes == tensor.numBytes(),
+          message:
+              'Output buffer of ${buffer.lengthInBytes} bytes does not match tensor size of ${tensor.numBytes()} bytes');
+    }
+    _outputBindings[index] = buffer;
+  }
+
+  /// Removes the buffer bound to output [index] with [bindOutput].
+  void unbindOutput(int index) {
+    _outputBindings.remove(index);
+  }
+
+  /// Removes all buffers bound with [bindOutput].
+  void clearOutputBindings() {
+    _outputBindings.clear();
   }
 
   /// Just run inference
+  ///
+  /// Typed inputs ([Float32List], [Int8List], ...) are copied into the input
+  /// tensors with a single memcpy each and never trigger a resize; they must
+  /// match the byte size of the tensor they are written to.
   void runInference(List<Object> inputs) {
     if (inputs.isEmpty) {
       throw ArgumentError('Input error: Inputs should not be null or empty.');
@@ -207,7 +899,6 @@ class Interpreter {
 
     if (!_allocated) {
       allocateTensors();
-      _allocated = true;
     }
 
     inputTensors = getInputTensors();
@@ -219,42 +910,72 @@ class Interpreter {
     invoke();
     _lastNativeInferenceDurationMicroSeconds =
         DateTime.now().microsecondsSinceEpoch - inferenceStartNanos;
+
+    if (_outputBindings.isNotEmpty) {
+      for (final entry in _outputBindings.entries) {
+        getOutputTensor(entry.key).copyTo(entry.value);
+      }
+    }
   }
 
   /// Gets all input tensors associated with the model.
   List<Tensor> getInputTensors() {
-    if (_inputTensors != null) {
-      return _inputTensors!;
+    final tensors = _inputTensors ??= _createInputTensors();
+    if (!_metadataValid) {
+      _refreshMetadata();
     }
-
-    var tensors = List.generate(
-        tfliteBinding.TfLiteInterpreterGetInputTensorCount(_interpreter),
-        (i) => Tensor(
-            tfliteBinding.TfLiteInterpreterGetInputTensor(_interpreter, i)),
-        growable: false);
-
     return tensors;
   }
 
   /// Gets all output tensors associated with the model.
   List<Tensor> getOutputTensors() {
-    if (_outputTensors != null) {
-      return _outputTensors!;
+    final tensors = _outputTensors ??= _createOutputTensors();
+    if (!_metadataValid) {
+      _refreshMetadata();
     }
+    return tensors;
+  }
 
+  List<Tensor> _createInputTensors() {
+    return List.generate(
+        tfliteBinding.TfLiteInterpreterGetInputTensorCount(_interpreter),
+        (i) => Tensor(
+            tfliteBinding.TfLiteInterpreterGetInputTensor(_interpreter, i)),
+        growable: false);
+  }
+
+  List<Tensor> _createOutputTensors() {
     final count =
         tfliteBinding.TfLiteInterpreterGetOutputTensorCount(_interpreter);
-    var tensors = List.generate(
+    return List.generate(
         count,
         (i) => Tensor(
             tfliteBinding.TfLiteInterpreterGetOutputTensor(_interpreter, i)),
         growable: false);
+  }
 
-    return tensors;
+  /// Caches shape, size, data pointer and quantization of every input and
+  /// output tensor with a single native call, so per-inference bookkeeping
+  /// does not cross the FFI boundary once per property.
+  void _refreshMetadata() {
+    if (!_cacheMetadata || !_allocated || _deleted) {
+      return;
+    }
+    _metadataValid = Tensor.snapshotMetadata(
+        _interpreter,
+        _inputTensors ??= _createInputTensors(),
+        _outputTensors ??= _createOutputTensors());
+  }
+
+  void _invalidateMetadata() {
+    Tensor.clearMetadata(_inputTensors ?? const []);
+    Tensor.clearMetadata(_outputTensors ?? const []);
+    _metadataValid = false;
   }
 
   /// Resize input tensor for the given tensor index. `allocateTensors` must be called again afterward.
   void resizeInputTensor(int tensorIndex, List<int> shape) {
+    _checkNoAsyncInvoke();
     final dimensionSize = shape.length;
     final dimensions = calloc<Int>(dimensionSize);
     final externalTypedData =
@@ -264,9 +985,11 @@ class Interpreter {
         _interpreter, tensorIndex, dimensions, dimensionSize);
     calloc.free(dimensions);
     checkState(status == TfLiteStatus.kTfLiteOk);
+    _invalidateMetadata();
     _inputTensors = null;
     _outputTensors = null;
     _allocated = false;
+    _generation++;
   }
 
   /// Gets the input Tensor for the provided input index.
@@ -276,13 +999,7 @@ class Interpreter {
     if (index < 0 || index >= _inputTensorsCount!) {
       throw ArgumentError('Invalid input Tensor index: $index');
     }
-    if (_inputTensors != null) {
-      return _inputTensors![index];
-    }
-
-    final inputTensor = Tensor(
-        tfliteBinding.TfLiteInterpreterGetInputTensor(_interpreter, index));
-    return inputTensor;
+    return getInputTensors()[index];
   }
 
   /// Gets the output Tensor for the provided output index.
@@ -292,21 +1009,13 @@ class Interpreter {
     if (index < 0 || index >= _outputTensorsCount!) {
       throw ArgumentError('Invalid output Tensor index: $index');
     }
-    if (_outputTensors != null) {
-      return _outputTensors![index];
-    }
-    final outputTensor = Tensor(
-        tfliteBinding.TfLiteInterpreterGetOutputTensor(_interpreter, index));
-    return outputTensor;
+    return getOutputTensors()[index];
   }
 
   /// Gets index of an input given the op name of the input.
   int getInputIndex(String opName) {
-    final inputTensors = getInputTensors();
-    var inputTensorsIndex = <String, int>{};
-    for (var i = 0; i < inputTensors.length; i++) {
-      inputTensorsIndex[inputTensors[i].name] = i;
-    }
+    final inputTensorsIndex =
+        _inputIndexByName ??= _indexByName(getInputTensors());
     if (inputTensorsIndex.containsKey(opName)) {
       return inputTensorsIndex[opName]!;
     } else {
@@ -317,11 +1026,8 @@ class Interpreter {
 
   /// Gets index of an output given the op name of the output.
   int getOutputIndex(String opName) {
-    final outputTensors = getOutputTensors();
-    var outputTensorsIndex = <String, int>{};
-    for (var i = 0; i < outputTensors.length; i++) {
-      outputTensorsIndex[outputTensors[i].name] = i;
-    }
+    final outputTensorsIndex =
+        _outputIndexByName ??= _indexByName(getOutputTensors());
     if (outputTensorsIndex.containsKey(opName)) {
       return outputTensorsIndex[opName]!;
     } else {
@@ -330,6 +1036,127 @@ class Interpreter {
     }
   }
 
+  static Map<String, int> _indexByName(List<Tensor> tensors) {
+    return {for (var i = 0; i < tensors.length; i++) tensors[i].name: i};
+  }
+
+  /// Prepares a [RunPlan] that copies [inputs] in, invokes and copies into
+  /// [outputs] with no per-call validation or allocation.
+  ///
+  /// [inputs] are bound to input tensors by position and [outputs] map output
+  /// indexes to their destination buffers. When [inputShapes] is given, input
+  /// tensors whose shape differs are resized and tensors are reallocated
+  /// first. Types and byte sizes are validated once, here.
+  ///
+  /// The plan becomes stale, and [RunPlan.execute] throws, once the
+  /// interpreter is resized, reallocated or closed. Outputs that inference
+  /// reallocates are located again after every run.
+  ///
+  /// Throws [ArgumentError] if a buffer does not match its tensor.
+  RunPlan prepare(
+    List<TypedData> inputs,
+    Map<int, TypedData> outputs, {
+    List<List<int>>? inputShapes,
+  }) {
+    checkState(!_deleted, message: 'Interpreter already deleted.');
+    if (inputShapes != null) {
+      final tensors = getInputTensors();
+      for (var i = 0; i < inputShapes.length; i++) {
+        if (!_listEquals(tensors[i].shape, inputShapes[i])) {
+          resizeInputTensor(i, inputShapes[i]);
+        }
+      }
+    }
+    if (!_allocated) {
+      allocateTensors();
+    }
+
+    final inputTensors = getInputTensors();
+    checkArgument(inputs.length <= inputTensors.length,
+        message:
+            'Got ${inputs.length} inputs for a model with ${inputTensors.length} inputs');
+    final inputTargets = <Uint8List>[];
+    final inputSources = <Uint8List>[];
+    for (var i = 0; i < inputs.length; i++) {
+      final tensor = inputTensors[i];
+      tensor.checkBuffer(inputs[i]);
+      inputTargets.add(_bytesOf(tensor.typedData));
+      inputSources.add(_bytesOf(inputs[i]));
+    }
+
+    final outputTensors = <Pointer<TfLiteTensor>>[];
+    final outputData = Int64List(outputs.length);
+    final outputSources = <Uint8List>[];
+    final outputTargets = <Uint8List>[];
+    for (final entry in outputs.entries) {
+      final tensor = getOutputTensor(entry.key);
+      tensor.checkBuffer(entry.value);
+      final native = tfliteBinding.TfLiteInterpreterGetOutputTensor(
+          _interpreter, entry.key);
+      outputData[outputTensors.length] =
+          tfliteBinding.TfLiteTensorData(native).address;
+      outputTensors.add(native);
+      outputSources.add(_bytesOf(tensor.typedData));
+      outputTargets.add(_bytesOf(entry.value));
+    }
+
+    return RunPlan._(this, _generation, inputSources, inputTargets,
+        outputTensors, outputData, outputSources, outputTargets);
+  }
+
+  static Uint8List _bytesOf(TypedData data) =>
+      data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+
+  static bool _listEquals(List<int> a, List<int> b) {
+    if (a.length != b.length) return false;
+    for (var i = 0; i < a.length; i++) {
+      if (a[i] != b[i]) return false;
+    }
+    return true;
+  }
+
+  /// Number of signatures (entry points) exported by the model.
+  int get signatureCount =>
+      tfliteBinding.TfLiteInterpreterGetSignatureCount(_interpreter);
+
+  /// Keys of the signatures exported by the model.
+  List<String> get signatureKeys => List.generate(
+      signatureCount,
+      (i) =>
+          tfliteGetSignatureKey(_interpreter, i).cast<Utf8>().toDartString());
+
+  /// Returns the [SignatureRunner] for the signature [key].
+  ///
+  /// Runners are cached per key and deleted by [close]. All runners share
+  /// this interpreter's weights.
+  ///
+  /// Throws [ArgumentError] if the model has no signature [key].
+  SignatureRunner getSignatureRunner(String key) {
+    checkState(!_deleted, message: 'Interpreter already deleted.');
+    final cached = _signatureRunners[key];
+    if (cached != null) {
+      return cached;
+    }
+    final nativeKey = key.toNativeUtf8();
+    final runner = tfliteBinding.TfLiteInterpreterGetSignatureRunner(
+        _interpreter, nativeKey.cast());
+    calloc.free(nativeKey);
+    return _signatureRunners[key] =
+        SignatureRunner(runner, key, _signatureTensorsChanged);
+  }
+
+  void _signatureTensorsChanged(bool reallocated) {
+    // A runner may share tensors with the primary subgraph.
+    if (reallocated) {
+      _generation++;
+      _invalidateMetadata();
+      _dynamicOutputs =
+          Tensor.anyDynamic(_outputTensors ??= _createOutputTensors());
+    } else {
+      _didInvoke();
+    }
+  }
+
   // Resets all variable tensors to the defaul value
   void resetVariableTensors() {
     checkState(_deleted,
@@ -346,3 +1173,250 @@ class Interpreter {
 
   //TODO: (JAVA) void modifyGraphWithDelegate(Delegate delegate)
 }
+
+/// Durations of the phases of [Interpreter.load], in microseconds.
+class InterpreterLoadTimings {
+  InterpreterLoadTimings._(
+      this.extractMicroseconds,
+      this.modelLoadMicroseconds,
+      this.createMicroseconds,
+      this.allocateMicroseconds,
+      this.warmUpMicroseconds,
+      this.warmUpRuns);
+
+  /// Time spent extracting the asset into the model cache, on the caller's
+  /// isolate.
+  final int extractMicroseconds;
+
+  /// Time spent mapping the model file.
+  final int modelLoadMicroseconds;
+
+  /// Time spent in `TfLiteInterpreterCreate`, including delegate setup.
+  final int createMicroseconds;
+
+  /// Time spent in `TfLiteInterpreterAllocateTensors`.
+  final int allocateMicroseconds;
+
+  /// Time spent in all warm-up invocations.
+  final int warmUpMicroseconds;
+
+  /// Number of warm-up invocations.
+  final int warmUpRuns;
+
+  /// Total load time.
+  int get totalMicroseconds =>
+      extractMicroseconds +
+      modelLoadMicroseconds +
+      createMicroseconds +
+      allocateMicroseconds +
+      warmUpMicroseconds;
+
+  @override
+  String toString() {
+    return 'InterpreterLoadTimings{extract: ${extractMicroseconds}us, modelLoad: ${modelLoadMicroseconds}us, create: ${createMicroseconds}us, allocate: ${allocateMicroseconds}us, warmUp: ${warmUpMicroseconds}us x $warmUpRuns}';
+  }
+}
+
+/// Durations of the phases of a native run, in nanoseconds from a monotonic
+/// clock.
+class RunTiming {
+  RunTiming._(this.copyInNanos, this.invokeNanos, this.copyOutNanos);
+
+  /// Time spent copying inputs into tensor memory.
+  final int copyInNanos;
+
+  /// Time spent in `TfLiteInterpreterInvoke`.
+  final int invokeNanos;
+
+  /// Time spent copying outputs out of tensor memory.
+  final int copyOutNanos;
+
+  /// Total time of the run.
+  int get totalNanos => copyInNanos + invokeNanos + copyOutNanos;
+
+  @override
+  String toString() {
+    return 'RunTiming{copyIn: ${copyInNanos}ns, invoke: ${invokeNanos}ns, copyOut: ${copyOutNanos}ns}';
+  }
+}
+
+/// Per-call latency statistics of [Interpreter.runMany], in nanoseconds.
+class RunManyStats {
+  RunManyStats._(Int64List latencies)
+      : latenciesNanos = latencies.asUnmodifiableView(),
+        _sorted = Int64List.fromList(latencies)..sort();
+
+  /// Latency of each call, in call order.
+  final Int64List latenciesNanos;
+  final Int64List _sorted;
+
+  /// Number of calls.
+  int get count => latenciesNanos.length;
+
+  /// Sum of all call latencies.
+  int get totalNanos => _sorted.fold(0, (sum, value) => sum + value);
+
+  /// Mean call latency.
+  int get meanNanos => count == 0 ? 0 : totalNanos ~/ count;
+
+  /// Fastest call.
+  int get minNanos => count == 0 ? 0 : _sorted.first;
+
+  /// Slowest call.
+  int get maxNanos => count == 0 ? 0 : _sorted.last;
+
+  /// Call latency at [percentile], between 0 and 100, by nearest rank.
+  int percentileNanos(double percentile) {
+    if (count == 0) {
+      return 0;
+    }
+    final rank = (percentile / 100 * count).ceil().clamp(1, count);
+    return _sorted[rank - 1];
+  }
+
+  /// Median call latency.
+  int get p50Nanos => percentileNanos(50);
+
+  /// 95th percentile call latency.
+  int get p95Nanos => percentileNanos(95);
+
+  /// 99th percentile call latency.
+  int get p99Nanos => percentileNanos(99);
+
+  @override
+  String toString() {
+    return 'RunManyStats{count: $count, mean: ${meanNanos}ns, p50: ${p50Nanos}ns, p95: ${p95Nanos}ns, p99: ${p99Nanos}ns, max: ${maxNanos}ns}';
+  }
+}
+
+/// Grow-only native scratch buffer, freed on [Interpreter.close].
+class _StagingBuffer {
+  Pointer<Uint8> _ptr = nullptr;
+  int _capacity = 0;
+
+  /// Returns at least [bytes] bytes of native memory. Contents are not kept
+  /// across calls that grow the buffer.
+  Pointer<Uint8> reserve(int bytes) {
+    if (bytes > _capacity) {
+      free();
+      _ptr = calloc<Uint8>(bytes);
+      _capacity = bytes;
+    }
+    return _ptr;
+  }
+
+  void free() {
+    if (_capacity > 0) {
+      calloc.free(_ptr);
+    }
+    _ptr = nullptr;
+    _capacity = 0;
+  }
+}
+
+/// Native argument arrays for [Interpreter._runNative], allocated once per
+/// interpreter and freed on [Interpreter.close].
+class _NativeRunArgs {
+  _NativeRunArgs(int inputCount, int outputCount)
+      : inputs = calloc<Pointer<Void>>(inputCount + 1),
+        inputSizes = calloc<Int64>(inputCount + 1),
+        outputs = calloc<Pointer<Void>>(outputCount + 1),
+        outputSizes = calloc<Int64>(outputCount + 1),
+        timing = calloc<TfLiteFlutterRunTiming>();
+
+  final Pointer<Pointer<Void>> inputs;
+  final Pointer<Int64> inputSizes;
+  final Pointer<Pointer<Void>> outputs;
+  final Pointer<Int64> outputSizes;
+  final Pointer<TfLiteFlutterRunTiming> timing;
+
+  void free() {
+    calloc.free(inputs);
+    calloc.free(inputSizes);
+    calloc.free(outputs);
+    calloc.free(outputSizes);
+    calloc.free(timing);
+  }
+}
+
+/// A prepared inference call returned by [Interpreter.prepare].
+///
+/// Holds byte views of the bound caller buffers and of the tensor memory, so
+/// [execute] only copies inputs, invokes and copies outputs.
+class RunPlan {
+  RunPlan._(
+      this._interpreter,
+      this._generation,
+      this._inputSources,
+      this._inputTargets,
+      this._outputTensors,
+      this._outputData,
+      this._outputSources,
+      this._outputTargets);
+
+  final Interpreter _interpreter;
+  final int _generation;
+  final List<Uint8List> _inputSources;
+  final List<Uint8List> _inputTargets;
+
+  // Dynamic outputs are reallocated by invoke, so when the interpreter has
+  // any, data addresses are checked after every run and the source views
+  // rebuilt when they move.
+  final List<Pointer<TfLiteTensor>> _outputTensors;
+  final Int64List _outputData;
+  final List<Uint8List> _outputSources;
+  final List<Uint8List> _outputTargets;
+
+  /// Whether the interpreter changed since the plan was prepared.
+  bool get isStale => _generation != _interpreter._generation;
+
+  /// Copies the bound inputs in, runs inference and copies the bound outputs
+  /// out.
+  ///
+  /// Without a thread placement this invokes the cached interpreter handle
+  /// directly, and outputs are only looked up again when the model has
+  /// dynamic outputs, so a run allocates nothing on the Dart heap.
+  ///
+  /// Throws [StateError] if the plan [isStale], or if a dynamic output no
+  /// longer matches the size of its buffer after inference.
+  void execute() {
+    checkState(!isStale,
+        message: 'RunPlan is stale, prepare it again after resizing.');
+    for (var i = 0; i < _inputTargets.length; i++) {
+      final target = _inputTargets[i];
+      target.setRange(0, target.length, _inputSources[i]);
+    }
+    final interpreter = _interpreter;
+    if (interpreter._placer == null) {
+      // [Interpreter.invoke] without the closure that applies a placement.
+      interpreter._checkNoAsyncInvoke();
+      final status =
+          tfliteBinding.TfLiteInterpreterInvoke(interpreter._interpreter);
+      checkState(status == TfLiteStatus.kTfLiteOk);
+      interpreter._didInvoke();
+    } else {
+      interpreter.invoke();
+    }
+    final relocate = interpreter._dynamicOutputs;
+    for (var i = 0; i < _outputTargets.length; i++) {
+      final target = _outputTargets[i];
+      if (relocate) {
+        _relocateOutput(i, target.length);
+      }
+      target.setRange(0, target.length, _outputSources[i]);
+    }
+  }
+
+  void _relocateOutput(int i, int expectedSize) {
+    final tensor = _outputTensors[i];
+    final data = tfliteBinding.TfLiteTensorData(tensor);
+    final size = tfliteBinding.TfLiteTensorByteSize(tensor);
+    if (data.address != _outputData[i] || size != _outputSources[i].length) {
+      checkState(isNotNull(data) && size == expectedSize,
+          message:
+              'Bound output $i produced $size bytes while the plan expects $expectedSize bytes');
+      _outputData[i] = data.address;
+      _outputSources[i] = data.cast<Uint8>().asTypedList(size);
+    }
+  }
+}
@@ -26,6 +26,8 @@ import 'package:flutter_litert/flutter_litert.dart';
 class InterpreterOptions {
   final Pointer<TfLiteInterpreterOptions> _options;
   bool _deleted = false;
+  int _sharedThreads = 0;
+  ThreadPlacer? _placer;
 
   Pointer<TfLiteInterpreterOptions> get base => _options;
 
@@ -39,6 +41,8 @@ class InterpreterOptions {
   void delete() {
     checkState(!_deleted, message: 'InterpreterOptions already deleted.');
     tfliteBinding.TfLiteInterpreterOptionsDelete(_options);
+    ComputeThreads.release(_sharedThreads);
+    _sharedThreads = 0;
     _deleted = true;
   }
 
@@ -46,6 +50,36 @@ class InterpreterOptions {
   set threads(int threads) =>
       tfliteBinding.TfLiteInterpreterOptionsSetNumThreads(_options, threads);
 
+  /// Uses up to [requested] CPU threads drawn from the process-wide
+  /// [ComputeThreads] budget and returns the number granted, which is at
+  /// least 1. The threads return to the budget when the options are deleted,
+  /// so delete them only after the interpreter is closed.
+  int useSharedThreads(int requested) {
+    checkState(!_deleted, message: 'InterpreterOptions already deleted.');
+    ComputeThreads.release(_sharedThreads);
+    _sharedThreads = ComputeThreads.acquire(requested);
+    threads = _sharedThreads;
+    return _sharedThreads;
+  }
+
+  /// Places the threads of interpreters created with these options.
+  ///
+  /// Thread pools started while the interpreter is created, allocated and
+  /// first invoked get the full placement, as does the thread behind
+  /// [Interpreter.invokeAsync]. Delegates such as XNNPack start their pool
+  /// when created, so add them with [addNewDelegate] after setting this.
+  /// Synchronous invocations restrict the calling thread to the placement's
+  /// CPUs only for their duration. See [ThreadPlacer] and
+  /// [Interpreter.threadPlacement]. Linux and Android only.
+  ThreadPlacement? get placement => _placer?.placement;
+
+  set placement(ThreadPlacement? placement) {
+    _placer = placement == null ? null : ThreadPlacer(placement);
+  }
+
+  /// Placer applying [placement], used by [Interpreter].
+  ThreadPlacer? get placer => _placer;
+
   /// TensorFlow version >= v2.2
   /// Set true to use NnApi Delegate for Android
   set useNnApiForAndroid(bool useNnApi) {
@@ -69,6 +103,19 @@ class InterpreterOptions {
     tfliteBinding.TfLiteInterpreterOptionsAddDelegate(_options, delegate.base);
   }
 
+  /// Creates a delegate with [create] and adds it, placing the threads it
+  /// starts with [placement] when one is set.
+  ///
+  /// ```dart
+  /// final delegate = options.addNewDelegate(() => XNNPackDelegate());
+  /// ```
+  T addNewDelegate<T extends Delegate>(T Function() create) {
+    final placer = _placer;
+    final delegate = placer == null ? create() : placer.startDelegate(create);
+    addDelegate(delegate);
+    return delegate;
+  }
+
   /// Registers MediaPipe custom ops (like Convolution2DTransposeBias).
   ///
   /// Call this before creating an interpreter for MediaPipe models that use
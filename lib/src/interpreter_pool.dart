@@ -0,0 +1,414 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:async';
+import 'dart:ffi';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart';
+import 'package:quiver/check.dart';
+import 'package:flutter_litert/src/bindings/bindings.dart';
+import 'package:flutter_litert/src/bindings/runtime_bindings.dart';
+import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
+
+import 'ffi/helper.dart';
+import 'interpreter.dart';
+import 'interpreter_options.dart';
+import 'model.dart';
+import 'tensor.dart';
+import 'tensor_view.dart';
+import 'thread_placement.dart';
+
+// Runs one request on a worker isolate and returns the requested outputs.
+typedef _RequestHandler = List<TensorView> Function(
+    List<Object> inputs, List<int>? outputIndexes);
+
+/// Pool of interpreters for one model, each owned by its own worker isolate.
+///
+/// Every worker creates and allocates its interpreter from the same [Model],
+/// so creating or growing the pool does not block the calling isolate, and
+/// the interpreters share the model's weights and only add their own
+/// activation buffers. Requests go to the worker with the fewest requests in
+/// flight, so with single-threaded interpreters throughput scales with the
+/// number of cores.
+class InterpreterPool {
+  InterpreterPool._(this._model, this._spawn, this.debugName);
+
+  /// Creates a pool of [size] interpreters for [model].
+  ///
+  /// Each interpreter gets options from [createOptions], or single-threaded
+  /// default options when omitted. The options are created on the calling
+  /// isolate; the interpreter, including any delegate preparation such as
+  /// XNNPack weight packing, is built on the worker. The pool holds its own
+  /// reference to [model], so the caller may delete it right away.
+  static Future<InterpreterPool> create(
+    Model model, {
+    required int size,
+    InterpreterOptions Function()? createOptions,
+    String debugName = 'TfLiteInterpreterPool',
+  }) async {
+    checkArgument(size > 0, message: 'Pool size must be positive');
+    model.retain();
+    final options = createOptions ?? _defaultOptions;
+    return _start(
+        InterpreterPool._(model,
+            (name) => _spawnInterpreterWorker(model, options, name), debugName),
+        size);
+  }
+
+  /// Creates a pool of [size] workers that run requests with the handler
+  /// returned by [createHandler] instead of an interpreter.
+  ///
+  /// [createHandler] is called once on each worker isolate, so it must be
+  /// sendable to an isolate.
+  @visibleForTesting
+  static Future<InterpreterPool> withHandler(
+    int size,
+    List<TensorView> Function(List<Object> inputs, List<int>? outputIndexes)
+            Function()
+        createHandler, {
+    String debugName = 'TfLiteInterpreterPool',
+  }) {
+    checkArgument(size > 0, message: 'Pool size must be positive');
+    return _start(
+        InterpreterPool._(null,
+            (name) => _PoolWorker.spawn(_handlerOf(createHandler), name),
+            debugName),
+        size);
+  }
+
+  static Future<InterpreterPool> _start(InterpreterPool pool, int size) async {
+    try {
+      await pool.resize(size);
+    } catch (_) {
+      await pool.close();
+      rethrow;
+    }
+    return pool;
+  }
+
+  static InterpreterOptions _defaultOptions() =>
+      InterpreterOptions()..threads = 1;
+
+  final Model? _model;
+  final Future<_PoolWorker> Function(String debugName) _spawn;
+  final String debugName;
+
+  final List<_PoolWorker> _workers = <_PoolWorker>[];
+  int _nextWorkerId = 0;
+  bool _closed = false;
+
+  /// Number of workers.
+  int get size => _workers.length;
+
+  /// Number of requests in flight on each worker.
+  List<int> get pendingCounts =>
+      List.unmodifiable(_workers.map((worker) => worker.pending.length));
+
+  /// Runs [inputs] on the least-loaded worker and returns the outputs.
+  ///
+  /// Only [outputIndexes] are returned when given, otherwise every output.
+  /// Each output is a contiguous [TensorView] copied out on the worker.
+  Future<List<TensorView>> run(List<Object> inputs,
+      {List<int>? outputIndexes}) {
+    checkState(!_closed, message: 'InterpreterPool already closed.');
+    checkState(_workers.isNotEmpty, message: 'InterpreterPool has no workers.');
+    var worker = _workers.first;
+    for (final candidate in _workers) {
+      if (candidate.pending.length < worker.pending.length) {
+        worker = candidate;
+      }
+    }
+    return worker.run(inputs, outputIndexes);
+  }
+
+  /// Runs [inputs] and copies the outputs in [outputs] into their
+  /// destinations, like [Interpreter.runForMultipleInputs].
+  ///
+  /// Destinations may be typed lists or [ByteBuffer]s matching the output
+  /// tensor, [TensorView]s, or nested lists of the output's shape.
+  Future<void> runForMultipleInputs(
+    List<Object> inputs,
+    Map<int, Object> outputs,
+  ) async {
+    final indexes = outputs.keys.toList(growable: false);
+    final views = await run(inputs, outputIndexes: indexes);
+    for (var i = 0; i < indexes.length; i++) {
+      final view = views[i];
+      final data = view.data;
+      Tensor.copyBytesTo(
+          data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes),
+          view.type,
+          view.shape,
+          outputs[indexes[i]]!);
+    }
+  }
+
+  /// Grows or shrinks the pool to [size] workers.
+  ///
+  /// Removed workers stop receiving requests right away and shut down once
+  /// their requests in flight complete.
+  Future<void> resize(int size) async {
+    checkState(!_closed, message: 'InterpreterPool already closed.');
+    checkArgument(size > 0, message: 'Pool size must be positive');
+    if (size < _workers.length) {
+      final removed = _workers.sublist(size);
+      _workers.removeRange(size, _workers.length);
+      await Future.wait(removed.map((worker) => worker.close()));
+      return;
+    }
+    final added = <Future<_PoolWorker>>[];
+    while (_workers.length + added.length < size) {
+      added.add(_spawnWorker());
+    }
+    // Keeps the workers that did start, so close() shuts them down even if
+    // another one failed.
+    Object? error;
+    StackTrace? stackTrace;
+    for (final spawning in added) {
+      try {
+        _workers.add(await spawning);
+      } catch (e, s) {
+        error ??= e;
+        stackTrace ??= s;
+      }
+    }
+    if (error != null) {
+      Error.throwWithStackTrace(error, stackTrace!);
+    }
+  }
+
+  /// Waits for requests in flight, then stops every worker and closes its
+  /// interpreter.
+  Future<void> close() async {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    final workers = List.of(_workers);
+    _workers.clear();
+    await Future.wait(workers.map((worker) => worker.close()));
+    _model?.release();
+  }
+
+  Future<_PoolWorker> _spawnWorker() => _spawn('$debugName-${_nextWorkerId++}');
+
+  static Future<_PoolWorker> _spawnInterpreterWorker(Model model,
+      InterpreterOptions Function() createOptions, String debugName) async {
+    final options = createOptions();
+    try {
+      // The options outlive the worker's interpreter, which uses them.
+      return await _PoolWorker.spawn(
+          _interpreterHandlerFor(model.base.address, options.base.address,
+              options.placer?.base.address ?? 0),
+          debugName,
+          onClosed: options.delete);
+    } catch (_) {
+      options.delete();
+      rethrow;
+    }
+  }
+
+  // Kept separate so the closures sent to the worker capture only their
+  // arguments.
+  static _WorkerHandler Function() _handlerOf(
+          _RequestHandler Function() createHandler) =>
+      () => _WorkerHandler(createHandler());
+
+  static _WorkerHandler Function() _interpreterHandlerFor(
+          int modelAddress, int optionsAddress, int placementAddress) =>
+      () => _interpreterHandler(
+          _createInterpreter(modelAddress, optionsAddress, placementAddress));
+
+  // Runs on the worker. Thread pools started while the interpreter is
+  // created and allocated get the options' placement.
+  static Interpreter _createInterpreter(
+      int modelAddress, int optionsAddress, int placementAddress) {
+    final placement =
+        Pointer<TfLiteFlutterPlacement>.fromAddress(placementAddress);
+    final placed = <int, int>{};
+    final pointer = ThreadPlacer.placeStartedBy(
+        placement,
+        () => tfliteBinding.TfLiteInterpreterCreate(
+            Pointer<TfLiteModel>.fromAddress(modelAddress),
+            Pointer<TfLiteInterpreterOptions>.fromAddress(optionsAddress)),
+        placed);
+    checkArgument(isNotNull(pointer),
+        message: 'Unable to create interpreter.');
+    final status = ThreadPlacer.placeStartedBy(placement,
+        () => tfliteBinding.TfLiteInterpreterAllocateTensors(pointer), placed);
+    if (status != TfLiteStatus.kTfLiteOk) {
+      tfliteBinding.TfLiteInterpreterDelete(pointer);
+      throw StateError('Unable to allocate tensors.');
+    }
+    return Interpreter.fromAddress(pointer.address);
+  }
+
+  static _WorkerHandler _interpreterHandler(Interpreter interpreter) {
+    return _WorkerHandler((inputs, outputIndexes) {
+      interpreter.runInference(inputs);
+      final indexes = outputIndexes ??
+          List.generate(interpreter.getOutputTensors().length, (i) => i);
+      return [
+        for (final i in indexes) interpreter.getOutputTensor(i).view.copy()
+      ];
+    }, interpreter.close);
+  }
+}
+
+/// Request handler of a worker and how to release what it holds.
+class _WorkerHandler {
+  _WorkerHandler(this.run, [this.close]);
+
+  final _RequestHandler run;
+  final void Function()? close;
+}
+
+/// One worker isolate running one request handler, usually an interpreter.
+class _PoolWorker {
+  _PoolWorker._(this._onClosed);
+
+  /// Starts a worker that calls [createHandler] on its own isolate. Fails
+  /// with a [RemoteError] if [createHandler] throws.
+  static Future<_PoolWorker> spawn(
+      _WorkerHandler Function() createHandler, String debugName,
+      {void Function()? onClosed}) async {
+    final worker = _PoolWorker._(onClosed);
+    final exitPort = ReceivePort();
+    worker._exited = exitPort.first;
+    final sendPortCompleter = Completer<SendPort>();
+    worker._receivePort.listen((message) {
+      if (message is SendPort) {
+        sendPortCompleter.complete(message);
+      } else if (message is _PoolResponse) {
+        if (!sendPortCompleter.isCompleted) {
+          sendPortCompleter.completeError(
+              RemoteError(message.error!, message.stackTrace ?? ''));
+        } else {
+          worker._complete(message);
+        }
+      }
+    });
+    await Isolate.spawn(
+      _workerMain,
+      [worker._receivePort.sendPort, createHandler],
+      debugName: debugName,
+      onExit: exitPort.sendPort,
+    );
+    try {
+      worker._sendPort = await sendPortCompleter.future;
+    } catch (_) {
+      await worker._exited;
+      worker._receivePort.close();
+      rethrow;
+    }
+    return worker;
+  }
+
+  final void Function()? _onClosed;
+  final ReceivePort _receivePort = ReceivePort();
+  late final SendPort _sendPort;
+  late final Future<Object?> _exited;
+
+  final Map<int, Completer<List<TensorView>>> pending =
+      <int, Completer<List<TensorView>>>{};
+  int _nextRequestId = 0;
+  bool _closing = false;
+
+  Future<List<TensorView>> run(List<Object> inputs, List<int>? outputIndexes) {
+    final id = _nextRequestId++;
+    final completer = Completer<List<TensorView>>();
+    pending[id] = completer;
+    _sendPort.send(_PoolRequest(id, inputs, outputIndexes));
+    return completer.future;
+  }
+
+  Future<void> close() async {
+    if (_closing) {
+      return;
+    }
+    _closing = true;
+    final inFlight = [for (final completer in pending.values) completer.future];
+    await Future.wait(inFlight).catchError((_) => <List<TensorView>>[]);
+    // The worker handles the shutdown message only after its last request,
+    // so the interpreter is never freed while it is being invoked.
+    _sendPort.send(null);
+    await _exited;
+    _receivePort.close();
+    _onClosed?.call();
+  }
+
+  void _complete(_PoolResponse response) {
+    final completer = pending.remove(response.id);
+    if (completer == null) {
+      return;
+    }
+    if (response.error != null) {
+      completer.completeError(
+          RemoteError(response.error!, response.stackTrace ?? ''));
+    } else {
+      completer.complete(response.outputs);
+    }
+  }
+
+  static Future<void> _workerMain(List<Object> args) async {
+    final sendPort = args[0] as SendPort;
+    final _WorkerHandler handler;
+    try {
+      handler = (args[1] as _WorkerHandler Function())();
+    } catch (error, stackTrace) {
+      sendPort.send(
+          _PoolResponse(-1, null, error.toString(), stackTrace.toString()));
+      return;
+    }
+    final port = ReceivePort();
+    sendPort.send(port.sendPort);
+
+    await for (final message in port) {
+      if (message == null) {
+        handler.close?.call();
+        port.close();
+        Isolate.exit();
+      }
+      final request = message as _PoolRequest;
+      try {
+        final outputs = handler.run(request.inputs, request.outputIndexes);
+        sendPort.send(_PoolResponse(request.id, outputs, null, null));
+      } catch (error, stackTrace) {
+        sendPort.send(_PoolResponse(
+            request.id, null, error.toString(), stackTrace.toString()));
+      }
+    }
+  }
+}
+
+class _PoolRequest {
+  _PoolRequest(this.id, this.inputs, this.outputIndexes);
+
+  final int id;
+  final List<Object> inputs;
+  final List<int>? outputIndexes;
+}
+
+class _PoolResponse {
+  _PoolResponse(this.id, this.outputs, this.error, this.stackTrace);
+
+  final int id;
+  final List<TensorView>? outputs;
+  final String? error;
+  final String? stackTrace;
+}
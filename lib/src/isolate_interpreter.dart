@@ -15,26 +15,102 @@
  */
 
 import 'dart:async';
+import 'dart:collection';
+import 'dart:ffi';
 import 'dart:isolate';
+import 'dart:typed_data';
 
+import 'package:flutter/foundation.dart';
 import 'package:flutter_litert/flutter_litert.dart';
 
+/// What [IsolateInterpreter] does with a request that arrives while its
+/// queue is full.
+enum IsolateQueuePolicy {
+  /// Keep every request in order. Requests beyond the queue bound are held
+  /// until there is room, without limit, so producers that can outrun the
+  /// model should await [IsolateInterpreter.waitForRoom] before submitting.
+  fifo,
+
+  /// Drop the oldest queued request to make room, so only the most recent
+  /// inputs (e.g. camera frames) are run.
+  latestWins,
+
+  /// Fail the new request with a [RequestDroppedException].
+  reject,
+}
+
+/// Turns the raw input passed to [IsolateInterpreter.process] into model
+/// inputs, on the interpreter's isolate.
+typedef IsolatePreprocess = List<Object> Function(Object input);
+
+/// Builds the result of [IsolateInterpreter.process] from the interpreter's
+/// output tensors, on the interpreter's isolate. The result is sent back to
+/// the caller, so it must be sendable to another isolate.
+typedef IsolatePostprocess = Object? Function(Interpreter interpreter);
+
+/// Thrown to callers of [IsolateInterpreter] whose request was not run.
+class RequestDroppedException implements Exception {
+  RequestDroppedException(this.message);
+
+  final String message;
+
+  @override
+  String toString() => 'RequestDroppedException: $message';
+}
+
 /// `IsolateInterpreter` allows for the execution of TensorFlow models within an isolate.
+///
+/// Requests are queued and sent to the isolate back to back. At most
+/// [maxQueueDepth] requests wait behind the ones already sent; what happens
+/// to further requests is set by [policy]. Every request gets its own
+/// future, which fails with [RequestDroppedException] if the request is
+/// dropped. [waitForRoom] lets producers slow down to the model's pace
+/// instead.
+///
+/// Only buffers from [NativeBuffer] cross the isolate boundary without a
+/// copy: the isolate reads and writes them in place. Other typed inputs and
+/// outputs are copied once into a [TransferableTypedData], which then moves
+/// between isolates without further copies. Outputs are copied out of the
+/// tensors on the isolate, which lets it start the next request right away.
+///
+/// With [preprocess] and [postprocess] hooks, [process] also moves input
+/// preparation (resize, normalize) and output decoding (box decoding, NMS)
+/// to the isolate, so only the raw input and a compact result cross it.
 class IsolateInterpreter {
   // Private constructor for the interpreter.
   IsolateInterpreter._({
     required this.address,
     required this.debugName,
+    required this.maxQueueDepth,
+    required this.policy,
+    required this.preprocess,
+    required this.postprocess,
+    this.handler,
   });
 
   // Factory method to create an instance of the IsolateInterpreter.
+  //
+  // [preprocess] and [postprocess] are run by [process] on the isolate and
+  // should be top-level or static functions.
   static Future<IsolateInterpreter> create({
     required int address,
     String debugName = 'TfLiteInterpreterIsolate',
+    int maxQueueDepth = 16,
+    IsolateQueuePolicy policy = IsolateQueuePolicy.fifo,
+    IsolatePreprocess? preprocess,
+    IsolatePostprocess? postprocess,
   }) async {
+    if (maxQueueDepth < 0) {
+      throw ArgumentError.value(
+          maxQueueDepth, 'maxQueueDepth', 'must not be negative');
+    }
     final interpreter = IsolateInterpreter._(
       address: address,
       debugName: debugName,
+      maxQueueDepth: maxQueueDepth,
+      policy: policy,
+      preprocess: preprocess,
+      postprocess: postprocess,
     );
 
     await interpreter._init();
@@ -42,14 +118,99 @@ class IsolateInterpreter {
     return interpreter;
   }
 
+  /// Creates an isolate interpreter that runs requests with [handler]
+  /// instead of a TFLite interpreter, e.g. to exercise the queue.
+  ///
+  /// [handler] receives the model inputs on the isolate and returns the
+  /// outputs; the [process] hooks are not run.
+  @visibleForTesting
+  static Future<IsolateInterpreter> withHandler(
+    List<TensorView> Function(List<Object> inputs) handler, {
+    String debugName = 'TfLiteInterpreterIsolate',
+    int maxQueueDepth = 16,
+    IsolateQueuePolicy policy = IsolateQueuePolicy.fifo,
+  }) async {
+    if (maxQueueDepth < 0) {
+      throw ArgumentError.value(
+          maxQueueDepth, 'maxQueueDepth', 'must not be negative');
+    }
+    final interpreter = IsolateInterpreter._(
+      address: 0,
+      debugName: debugName,
+      maxQueueDepth: maxQueueDepth,
+      policy: policy,
+      preprocess: null,
+      postprocess: null,
+      handler: handler,
+    );
+    await interpreter._init();
+    return interpreter;
+  }
+
   final int address;
   final String debugName;
 
-  late final Interpreter _callerInterpreter;
+  /// Maximum number of requests waiting to be sent to the isolate.
+  final int maxQueueDepth;
+
+  /// What happens to requests arriving while the queue is full.
+  final IsolateQueuePolicy policy;
+
+  /// Hook run by [process] before inference, on the isolate.
+  final IsolatePreprocess? preprocess;
+
+  /// Hook run by [process] after inference, on the isolate.
+  final IsolatePostprocess? postprocess;
+
+  // Replaces the interpreter on the isolate; see [withHandler].
+  final List<TensorView> Function(List<Object> inputs)? handler;
+
+  // Requests sent to the isolate, in order. The second one waits in the
+  // isolate's port so it starts as soon as the first completes.
+  static const int _maxInFlight = 2;
+  final Queue<_QueuedRequest> _inFlight = Queue<_QueuedRequest>();
+  final Queue<_QueuedRequest> _queue = Queue<_QueuedRequest>();
+  // Requests beyond [maxQueueDepth] under [IsolateQueuePolicy.fifo].
+  final Queue<_QueuedRequest> _blocked = Queue<_QueuedRequest>();
+  // Callers of [waitForRoom].
+  final Queue<Completer<void>> _roomWaiters = Queue<Completer<void>>();
+  int _droppedCount = 0;
+  int _completedCount = 0;
+
+  /// Number of requests waiting to be sent to the isolate.
+  int get queueDepth => _queue.length + _blocked.length;
+
+  /// Number of requests dropped by [policy] or by [close].
+  int get droppedCount => _droppedCount;
+
+  /// Number of requests that ran to completion, successfully or not.
+  int get completedCount => _completedCount;
+
+  // Number of requests that would be dispatched or queued without being
+  // held back or dropped by [policy].
+  int get _room => _blocked.isNotEmpty
+      ? 0
+      : _maxInFlight - _inFlight.length + maxQueueDepth - _queue.length;
+
+  /// Completes once a new request would be queued without being held back
+  /// or dropped by [policy], or once the interpreter is closed.
+  ///
+  /// Awaiting it before each request bounds the memory a fast producer can
+  /// pin under [IsolateQueuePolicy.fifo]. Waiters are woken in order, one
+  /// per free slot.
+  Future<void> waitForRoom() {
+    if (_closed || (_room > 0 && _roomWaiters.isEmpty)) {
+      return Future<void>.value();
+    }
+    final waiter = Completer<void>();
+    _roomWaiters.add(waiter);
+    return waiter.future;
+  }
 
   final ReceivePort _receivePort = ReceivePort();
   late final SendPort _sendPort;
   late final Isolate _isolate;
+  late final Future<Object?> _exited;
   bool _closed = false;
 
   // Controller to handle state changes.
@@ -70,31 +231,34 @@ class IsolateInterpreter {
 
   // Initialize the isolate and set up communication.
   Future<void> _init() async {
+    final exitPort = ReceivePort();
+    _exited = exitPort.first;
     _isolate = await Isolate.spawn(
       _mainIsolate,
-      _receivePort.sendPort,
+      [_receivePort.sendPort, preprocess, postprocess, handler],
       debugName: debugName,
+      onExit: exitPort.sendPort,
     );
     final Completer<SendPort> sendPortCompleter = Completer<SendPort>();
 
-    _stateSubscription = _receivePort.listen((state) {
-      if (state is SendPort) {
-        _sendPort = state;
+    _stateSubscription = _receivePort.listen((message) {
+      if (message is SendPort) {
+        _sendPort = message;
         sendPortCompleter.complete(_sendPort);
-      }
-
-      if (state is IsolateInterpreterState) {
-        _state = state;
+      } else if (message is _IsolateInterpreterResult) {
+        _onResult(message);
       }
     });
 
     await sendPortCompleter.future;
-
-    _callerInterpreter = Interpreter.fromAddress(address);
   }
 
   // Main function for the spawned isolate.
-  static Future<void> _mainIsolate(SendPort sendPort) async {
+  static Future<void> _mainIsolate(List<Object?> args) async {
+    final sendPort = args[0] as SendPort;
+    final preprocess = args[1] as IsolatePreprocess?;
+    final postprocess = args[2] as IsolatePostprocess?;
+    final handler = args[3] as List<TensorView> Function(List<Object>)?;
     final port = ReceivePort();
 
     sendPort.send(port.sendPort);
@@ -103,16 +267,83 @@ class IsolateInterpreter {
     int? cachedAddress;
 
     await for (final _IsolateInterpreterData data in port) {
-      if (cachedInterpreter == null || cachedAddress != data.address) {
-        cachedInterpreter = Interpreter.fromAddress(data.address);
-        cachedAddress = data.address;
+      try {
+        var inputs = data.inputs.map(_decodeInput).toList(growable: false);
+        if (handler != null) {
+          final outputs = [
+            for (final view in handler(inputs)) _TransferredTensor.ofView(view)
+          ];
+          sendPort.send(_IsolateInterpreterResult(outputs, null, null, null));
+          continue;
+        }
+        if (cachedInterpreter == null || cachedAddress != data.address) {
+          cachedInterpreter = Interpreter.fromAddress(data.address);
+          cachedAddress = data.address;
+        }
+        if (data.processed && preprocess != null) {
+          inputs = preprocess(inputs.single);
+        }
+        cachedInterpreter.runInference(inputs);
+        if (data.processed && postprocess != null) {
+          final result = postprocess(cachedInterpreter);
+          sendPort.send(_IsolateInterpreterResult(null, result, null, null));
+        } else {
+          final outputs = _readOutputs(cachedInterpreter, data);
+          sendPort.send(_IsolateInterpreterResult(outputs, null, null, null));
+        }
+      } catch (error, stackTrace) {
+        sendPort.send(_IsolateInterpreterResult(
+            null, null, error.toString(), stackTrace.toString()));
       }
-      sendPort.send(IsolateInterpreterState.loading);
-      cachedInterpreter.runInference(data.inputs);
-      sendPort.send(IsolateInterpreterState.idle);
     }
   }
 
+  // Copies the requested outputs on the isolate, straight into native
+  // destinations when the caller passed one.
+  static List<_TransferredTensor> _readOutputs(
+      Interpreter interpreter, _IsolateInterpreterData data) {
+    final indexes = data.outputIndexes ??
+        List.generate(interpreter.getOutputTensors().length, (i) => i);
+    final outputs = <_TransferredTensor>[];
+    for (var i = 0; i < indexes.length; i++) {
+      final tensor = interpreter.getOutputTensor(indexes[i]);
+      final destination = data.outputDestinations?[i];
+      if (destination != null) {
+        tensor.copyTo(destination.asTypedList());
+        outputs.add(_TransferredTensor(null, tensor.type, tensor.shape));
+      } else {
+        final data = TransferableTypedData.fromList([tensor.typedData]);
+        outputs.add(_TransferredTensor(data, tensor.type, tensor.shape));
+      }
+    }
+    return outputs;
+  }
+
+  // Wraps typed inputs so they are moved, not copied, to the isolate.
+  static Object _encodeInput(Object input) {
+    if (input is ByteBuffer) {
+      input = input.asUint8List();
+    }
+    if (input is! TypedData) {
+      return input;
+    }
+    final span = _NativeSpan.of(input);
+    if (span != null) {
+      return span;
+    }
+    return _TransferredTensor(TransferableTypedData.fromList([input]),
+        _typeOf(input), const <int>[]);
+  }
+
+  static Object _decodeInput(Object input) {
+    if (input is _NativeSpan) {
+      return input.asTypedList();
+    }
+    if (input is _TransferredTensor) {
+      return input.materialize();
+    }
+    return input;
+  }
   /// Run TensorFlow model for single input and output.
   Future<void> run(Object input, Object output) {
     var map = <int, Object>{};
@@ -122,39 +353,141 @@ class IsolateInterpreter {
   }
 
   /// Run TensorFlow model for multiple inputs and outputs.
+  ///
+  /// Throws [RequestDroppedException] if the request was dropped.
   Future<void> runForMultipleInputs(
     List<Object> inputs,
     Map<int, Object> outputs,
-  ) async {
+  ) {
+    final indexes = outputs.keys.toList(growable: false);
+    final destinations = [
+      for (final index in indexes) _NativeSpan.of(outputs[index]!)
+    ];
+    return _enqueue(inputs, indexes, destinations, false, (result) {
+      for (var i = 0; i < indexes.length; i++) {
+        result.outputs![i].copyInto(outputs[indexes[i]]!);
+      }
+    });
+  }
+
+  /// Runs the model and returns the outputs as [TensorView]s.
+  ///
+  /// Each view is a contiguous snapshot of one output tensor, so no nested
+  /// lists are built. Only [outputIndexes] are copied when given, otherwise
+  /// every output is returned.
+  ///
+  /// Throws [RequestDroppedException] if the request was dropped.
+  Future<List<TensorView>> runForViews(
+    List<Object> inputs, {
+    List<int>? outputIndexes,
+  }) async {
+    var views = const <TensorView>[];
+    await _enqueue(inputs, outputIndexes, null, false, (result) {
+      views = [for (final output in result.outputs!) output.toView()];
+    });
+    return views;
+  }
+
+  /// Runs [preprocess], the model and [postprocess] on the isolate for one
+  /// raw [input] and returns the result of [postprocess].
+  ///
+  /// Without [preprocess], [input] is the only model input. Without
+  /// [postprocess], every output is returned as a [TensorView] list.
+  ///
+  /// Throws [RequestDroppedException] if the request was dropped.
+  Future<Object?> process(Object input) async {
+    Object? processed;
+    await _enqueue([input], null, null, true, (result) {
+      processed = postprocess != null
+          ? result.processed
+          : [for (final output in result.outputs!) output.toView()];
+    });
+    return processed;
+  }
+
+  // Queues a request according to [policy]. [readOutputs] receives the
+  // outputs listed in [outputIndexes], or every output when null, or the
+  // hook result when [processed] is set.
+  Future<void> _enqueue(
+    List<Object> inputs,
+    List<int>? outputIndexes,
+    List<_NativeSpan?>? outputDestinations,
+    bool processed,
+    void Function(_IsolateInterpreterResult result) readOutputs,
+  ) {
+    final request = _QueuedRequest(inputs, outputIndexes, outputDestinations,
+        processed, readOutputs);
     if (_closed) {
-      return;
-    }
-    if (state == IsolateInterpreterState.loading) {
-      return;
+      _drop(request, 'IsolateInterpreter is closed');
+    } else if (_inFlight.length < _maxInFlight) {
+      _dispatch(request);
+    } else if (_queue.length < maxQueueDepth) {
+      _queue.add(request);
+    } else {
+      switch (policy) {
+        case IsolateQueuePolicy.fifo:
+          _blocked.add(request);
+        case IsolateQueuePolicy.latestWins:
+          if (_queue.isEmpty) {
+            _drop(request, 'Superseded by a newer request');
+          } else {
+            _drop(_queue.removeFirst(), 'Superseded by a newer request');
+            _queue.add(request);
+          }
+        case IsolateQueuePolicy.reject:
+          _drop(request, 'Request queue is full');
+      }
     }
-    _state = IsolateInterpreterState.loading;
+    return request.completer.future;
+  }
 
-    final data = _IsolateInterpreterData(
+  void _dispatch(_QueuedRequest request) {
+    _inFlight.add(request);
+    _state = IsolateInterpreterState.loading;
+    _sendPort.send(_IsolateInterpreterData(
       address: address,
-      inputs: inputs,
-    );
+      inputs: request.inputs.map(_encodeInput).toList(growable: false),
+      outputIndexes: request.outputIndexes,
+      outputDestinations: request.outputDestinations,
+      processed: request.processed,
+    ));
+  }
 
-    _sendPort.send(data);
-    await _wait();
+  void _onResult(_IsolateInterpreterResult result) {
+    if (_inFlight.isEmpty) {
+      return;
+    }
+    // The isolate handles requests in order, so results arrive in order.
+    final request = _inFlight.removeFirst();
+    _completedCount++;
+    if (result.error != null) {
+      request.completer
+          .completeError(RemoteError(result.error!, result.stackTrace ?? ''));
+    } else {
+      try {
+        request.readOutputs(result);
+        request.completer.complete();
+      } catch (error, stackTrace) {
+        request.completer.completeError(error, stackTrace);
+      }
+    }
 
-    final outputTensors = _callerInterpreter.getOutputTensors();
-    for (var i = 0; i < outputTensors.length; i++) {
-      outputTensors[i].copyTo(outputs[i]!);
+    if (_blocked.isNotEmpty) {
+      _queue.add(_blocked.removeFirst());
+    }
+    if (_queue.isNotEmpty && !_closed) {
+      _dispatch(_queue.removeFirst());
+    } else if (_inFlight.isEmpty) {
+      _state = IsolateInterpreterState.idle;
+    }
+    for (var room = _room; room > 0 && _roomWaiters.isNotEmpty; room--) {
+      _roomWaiters.removeFirst().complete();
     }
   }
 
-  // Wait for the state to change to idle.
-  Future<void> _wait() async {
-    if (state == IsolateInterpreterState.loading) {
-      await for (final state in stateChanges) {
-        if (state == IsolateInterpreterState.idle) break;
-      }
-    }
+  void _drop(_QueuedRequest request, String reason) {
+    _droppedCount++;
+    request.completer.completeError(RequestDroppedException(reason));
   }
 
   // Close resources and terminate the isolate.
@@ -164,12 +497,32 @@ class IsolateInterpreter {
   // the background isolate is killed immediately. Otherwise the native
   // interpreter can be freed (TfLiteInterpreterDelete) while the background
   // isolate's thread still holds references to its memory → crash.
+  //
+  // Killing does not interrupt native code, so a request in flight may
+  // still be reading its inputs or writing its [NativeBuffer] outputs.
+  // Those requests, and the buffers they hold, are kept until the isolate
+  // has exited; only then are they dropped. Await close() before freeing
+  // the interpreter or the buffers.
   Future<void> close() async {
     if (_closed) {
       return;
     }
     _closed = true;
     _isolate.kill();
+    for (final request in [..._queue, ..._blocked]) {
+      _drop(request, 'IsolateInterpreter is closed');
+    }
+    _queue.clear();
+    _blocked.clear();
+    for (final waiter in _roomWaiters) {
+      waiter.complete();
+    }
+    _roomWaiters.clear();
+    await _exited;
+    for (final request in _inFlight) {
+      _drop(request, 'IsolateInterpreter is closed');
+    }
+    _inFlight.clear();
     await _stateSubscription.cancel();
     await _stateChanges.close();
   }
@@ -186,8 +539,130 @@ class _IsolateInterpreterData {
   _IsolateInterpreterData({
     required this.address,
     required this.inputs,
+    required this.outputIndexes,
+    required this.outputDestinations,
+    required this.processed,
   });
 
   final int address;
   final List<Object> inputs;
+  final List<int>? outputIndexes;
+  final List<_NativeSpan?>? outputDestinations;
+  // Whether to run the preprocess and postprocess hooks.
+  final bool processed;
+}
+
+// Outcome of one request, sent back by the isolate.
+class _IsolateInterpreterResult {
+  _IsolateInterpreterResult(
+      this.outputs, this.processed, this.error, this.stackTrace);
+
+  final List<_TransferredTensor>? outputs;
+  // Result of the postprocess hook.
+  final Object? processed;
+  final String? error;
+  final String? stackTrace;
+}
+
+// A request waiting in, or dispatched from, the queue.
+class _QueuedRequest {
+  _QueuedRequest(this.inputs, this.outputIndexes, this.outputDestinations,
+      this.processed, this.readOutputs);
+
+  // Holding the inputs and destinations keeps native buffers alive until
+  // the isolate is done with them.
+  final List<Object> inputs;
+  final List<int>? outputIndexes;
+  final List<_NativeSpan?>? outputDestinations;
+  final bool processed;
+  final void Function(_IsolateInterpreterResult result) readOutputs;
+  final Completer<void> completer = Completer<void>();
+}
+
+// Native memory of a [NativeBuffer], shared with the isolate by address.
+class _NativeSpan {
+  _NativeSpan(this.address, this.lengthInBytes);
+
+  static _NativeSpan? of(Object data) {
+    if (data is! TypedData) {
+      return null;
+    }
+    final pointer = NativeBuffer.addressOf(data);
+    if (pointer == null) {
+      return null;
+    }
+    return _NativeSpan(pointer.address, data.lengthInBytes);
+  }
+
+  final int address;
+  final int lengthInBytes;
+
+  Uint8List asTypedList() =>
+      Pointer<Uint8>.fromAddress(address).asTypedList(lengthInBytes);
+}
+
+// Typed data moved between isolates, or only its type and shape when the
+// data was written to a native destination in place.
+class _TransferredTensor {
+  _TransferredTensor(this.data, this.type, this.shape);
+
+  factory _TransferredTensor.ofView(TensorView view) {
+    final data = TransferableTypedData.fromList([view.copy().data]);
+    return _TransferredTensor(data, view.type, view.shape);
+  }
+
+  final TransferableTypedData? data;
+  final TensorType type;
+  final List<int> shape;
+
+  TypedData materialize() => _typedView(data!.materialize(), type);
+
+  TensorView toView() => TensorView(materialize(), shape, type: type);
+
+  void copyInto(Object destination) {
+    if (data == null) {
+      return;
+    }
+    final bytes = data!.materialize().asUint8List();
+    Tensor.copyBytesTo(bytes, type, shape, destination);
+  }
+}
+
+TensorType _typeOf(TypedData data) {
+  if (data is Float32List) return TensorType.float32;
+  if (data is Float64List) return TensorType.float64;
+  if (data is Int64List) return TensorType.int64;
+  if (data is Uint64List) return TensorType.uint64;
+  if (data is Int32List) return TensorType.int32;
+  if (data is Uint32List) return TensorType.uint32;
+  if (data is Int16List) return TensorType.int16;
+  if (data is Uint16List) return TensorType.uint16;
+  if (data is Int8List) return TensorType.int8;
+  return TensorType.uint8;
+}
+
+TypedData _typedView(ByteBuffer buffer, TensorType type) {
+  switch (type) {
+    case TensorType.float32:
+      return buffer.asFloat32List();
+    case TensorType.float64:
+      return buffer.asFloat64List();
+    case TensorType.int64:
+      return buffer.asInt64List();
+    case TensorType.uint64:
+      return buffer.asUint64List();
+    case TensorType.int32:
+      return buffer.asInt32List();
+    case TensorType.uint32:
+      return buffer.asUint32List();
+    case TensorType.int16:
+      return buffer.asInt16List();
+    case TensorType.uint16:
+    case TensorType.float16:
+      return buffer.asUint16List();
+    case TensorType.int8:
+      return buffer.asInt8List();
+    default:
+      return buffer.asUint8List();
+  }
 }
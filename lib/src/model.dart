@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 import 'dart:ffi';
+import 'dart:io';
+import 'dart:isolate';
 import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
@@ -22,15 +24,77 @@ import 'package:flutter_litert/src/bindings/bindings.dart';
 import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
 
 import 'ffi/helper.dart';
+import 'model_cache.dart';
 
 /// TensorFlowLite model.
+///
+/// A model is reference counted so that many interpreters can share its
+/// read-only weights (see [Interpreter.fromModel]): models loaded with
+/// [Model.fromFile] are memory-mapped once, and models loaded with
+/// [Model.fromBuffer] keep a single native copy of the buffer. Every
+/// interpreter created from the model holds a reference, and [delete]
+/// releases the reference of the code that loaded it. The native model and
+/// buffer are freed once the last reference is released.
 class Model {
   final Pointer<TfLiteModel> _model;
+  final Pointer<Uint8> _buffer;
+  final int _bufferSize;
+  final String? _path;
+  String? _cacheKey;
   bool _deleted = false;
+  bool _released = false;
+  int _references = 1;
 
   Pointer<TfLiteModel> get base => _model;
 
-  Model._(this._model);
+  /// Whether the native model has been freed.
+  bool get isDeleted => _deleted;
+
+  /// Number of live references: the loader's, until [delete], plus one per
+  /// interpreter created from the model and not yet closed.
+  int get referenceCount => _references;
+
+  Model._(this._model,
+      {Pointer<Uint8>? buffer, int bufferSize = 0, String? path})
+      : _buffer = buffer ?? nullptr,
+        _bufferSize = bufferSize,
+        _path = path;
+
+  /// Key that changes with the model contents, for caches such as
+  /// [Interpreter.autoTune].
+  ///
+  /// For a model file it is built from the path, size and modification
+  /// time, so the file is never read. For a buffer it is the
+  /// [ModelCache.contentHash] of the native copy, computed once on a
+  /// background isolate.
+  Future<String> get cacheKey async {
+    final cached = _cacheKey;
+    if (cached != null) {
+      return cached;
+    }
+    checkState(!_deleted, message: 'Model already deleted.');
+    final path = _path;
+    if (path != null) {
+      final file = File(path).absolute;
+      final stat = await file.stat();
+      return _cacheKey = 'file:${file.path}:${stat.size}:'
+          '${stat.modified.microsecondsSinceEpoch}';
+    }
+    // Keeps the buffer alive while the background isolate reads it.
+    retain();
+    try {
+      final hash = await _hashInBackground(_buffer.address, _bufferSize);
+      return _cacheKey = 'buffer:$hash';
+    } finally {
+      release();
+    }
+  }
+
+  // Kept static so the isolate closure captures nothing but its arguments.
+  static Future<String> _hashInBackground(int address, int size) {
+    return Isolate.run(() => ModelCache.contentHash(
+        Pointer<Uint8>.fromAddress(address).asTypedList(size)));
+  }
 
   /// Loads model from a file or throws if unsuccessful.
   factory Model.fromFile(String path) {
@@ -39,7 +103,7 @@ class Model {
     calloc.free(cpath);
     checkArgument(isNotNull(model),
         message: 'Unable to create model from file');
-    return Model._(model);
+    return Model._(model, path: path);
   }
 
   /// Loads model from a buffer or throws if unsuccessful.
@@ -49,15 +113,44 @@ class Model {
     final externalTypedData = ptr.asTypedList(size);
     externalTypedData.setRange(0, buffer.length, buffer);
     final model = tfliteBinding.TfLiteModelCreate(ptr.cast(), buffer.length);
+    if (!isNotNull(model)) {
+      calloc.free(ptr);
+    }
     checkArgument(isNotNull(model),
         message: 'Unable to create model from buffer');
-    return Model._(model);
+    return Model._(model, buffer: ptr, bufferSize: size);
   }
 
-  /// Destroys the model instance.
+  /// Releases the reference held by the code that loaded the model.
+  ///
+  /// The model is destroyed right away if no interpreter uses it, otherwise
+  /// when the last such interpreter is closed.
   void delete() {
+    checkState(!_released, message: 'Model already deleted.');
+    _released = true;
+    release();
+  }
+
+  /// Adds a reference, keeping the model alive until a matching [release].
+  ///
+  /// Called by [Interpreter] for every interpreter created from the model.
+  void retain() {
     checkState(!_deleted, message: 'Model already deleted.');
+    _references++;
+  }
+
+  /// Drops a reference added by [retain], destroying the model when none
+  /// remain.
+  void release() {
+    checkState(!_deleted && _references > 0,
+        message: 'Model already deleted.');
+    if (--_references > 0) {
+      return;
+    }
     tfliteBinding.TfLiteModelDelete(_model);
+    if (isNotNull(_buffer)) {
+      calloc.free(_buffer);
+    }
     _deleted = true;
   }
 }
@@ -0,0 +1,417 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter/services.dart';
+import 'package:flutter_litert/src/bindings/runtime_bindings.dart';
+import 'package:path/path.dart' as p;
+
+import 'model.dart';
+import 'util/zstd_decoder.dart';
+
+/// How a cached model file is warmed before it is memory-mapped.
+enum ModelPrefetch {
+  /// Leave paging to the kernel; pages fault in on first use.
+  none,
+
+  /// Advise the kernel that the whole file is needed soon, without blocking.
+  willNeed,
+
+  /// Read the whole file once so it is resident before the first inference.
+  prefault,
+}
+
+/// Size and timing of one compressed model extraction.
+class DecompressionStats {
+  DecompressionStats(
+      this.compressedBytes, this.decompressedBytes, this.elapsedMicroseconds);
+
+  /// Size of the compressed asset.
+  final int compressedBytes;
+
+  /// Size of the decompressed model written to the cache.
+  final int decompressedBytes;
+
+  /// Time spent decompressing and writing, in microseconds.
+  final int elapsedMicroseconds;
+
+  /// Decompressed megabytes (10^6 bytes) written per second.
+  double get megabytesPerSecond =>
+      elapsedMicroseconds == 0 ? 0 : decompressedBytes / elapsedMicroseconds;
+
+  @override
+  String toString() {
+    return 'DecompressionStats{compressed: $compressedBytes, decompressed: $decompressedBytes, elapsed: ${elapsedMicroseconds}us, ${megabytesPerSecond.toStringAsFixed(1)} MB/s}';
+  }
+}
+
+/// On-disk cache of model files, keyed by content hash.
+///
+/// Assets are extracted once into [directory] as `<hash>.tflite` and then
+/// opened with [Model.fromFile], which memory-maps them read-only. The model
+/// therefore never lives on the Dart or native heap: only the transient
+/// [ByteData] from the asset bundle is held while a new asset is extracted.
+///
+/// Extraction hashes the asset on a background isolate, so a changed asset
+/// always gets a new file. Without a `cacheKey` every launch still reads and
+/// hashes the whole asset; passing one (for example the app build number)
+/// lets later launches skip reading the asset entirely while the key is
+/// unchanged.
+class ModelCache {
+  ModelCache(this.directory);
+
+  /// Cache in `flutter_litert_models` under the system temporary directory,
+  /// which is the app cache directory on mobile platforms.
+  static final ModelCache defaultCache = ModelCache(
+      Directory(p.join(Directory.systemTemp.path, 'flutter_litert_models')));
+
+  /// Directory holding the cached model files.
+  final Directory directory;
+
+  // Cached files already resolved by this process, by asset name and key.
+  final Map<String, File> _resolved = <String, File>{};
+
+  static int _tempCounter = 0;
+
+  /// Whether [assetName] is treated as compressed by
+  /// [Interpreter.fromCachedAsset]: `.gz`, `.zz`, `.deflate` or `.zst`. The
+  /// format is taken from the data itself, not the extension.
+  static bool isCompressedAssetName(String assetName) {
+    final extension = p.extension(assetName).toLowerCase();
+    return const {'.gz', '.zz', '.deflate', '.zst'}.contains(extension);
+  }
+
+  /// Returns the cached file for [assetName], extracting it if needed.
+  Future<File> extractAsset(String assetName, {String? cacheKey}) async {
+    final resolvedKey = '$assetName\u0000${cacheKey ?? ''}';
+    final known = _resolved[resolvedKey];
+    if (known != null && await known.exists()) {
+      return known;
+    }
+
+    final indexed = await _readIndex(assetName, cacheKey);
+    if (indexed != null) {
+      return _resolved[resolvedKey] = indexed;
+    }
+
+    final data = await rootBundle.load(assetName);
+    final file = await put(
+        data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes));
+    await _writeIndex(assetName, cacheKey, file);
+    return _resolved[resolvedKey] = file;
+  }
+
+  /// Returns the cached, decompressed file for the compressed [assetName],
+  /// decompressing it if needed.
+  ///
+  /// gzip, zlib, raw deflate and zstd streams are supported. Decompression
+  /// runs on a background isolate and writes straight into the cache file,
+  /// so the decompressed model is never held in memory: deflate streams are
+  /// fed [chunkSize] bytes of input at a time, and zstd frames are written
+  /// block by block with only their window kept (see [ZstdDecoder]). The
+  /// file is keyed by the hash of the compressed bytes, so later loads skip
+  /// decompression; [cacheKey] additionally skips reading the asset, as in
+  /// [extractAsset]. [onDecompressed] receives throughput and timing
+  /// whenever decompression actually ran.
+  ///
+  /// Throws [FormatException] for corrupt data, and [UnsupportedError] for
+  /// zstd frames that need a dictionary or a window above
+  /// [ZstdDecoder.maxWindowSize].
+  Future<File> extractCompressedAsset(String assetName,
+      {String? cacheKey,
+      int chunkSize = 1 << 20,
+      void Function(DecompressionStats stats)? onDecompressed}) async {
+    final resolvedKey = '$assetName\u0000${cacheKey ?? ''}';
+    final known = _resolved[resolvedKey];
+    if (known != null && await known.exists()) {
+      return known;
+    }
+    final indexed = await _readIndex(assetName, cacheKey);
+    if (indexed != null) {
+      return _resolved[resolvedKey] = indexed;
+    }
+
+    final data = await rootBundle.load(assetName);
+    final compressed =
+        data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+    final extraction = await _decompressInBackground(
+        compressed, directory.path, _tempCounter++, chunkSize);
+    final file = fileFor(extraction.hash);
+    final stats = extraction.stats;
+    if (stats != null) {
+      onDecompressed?.call(stats);
+    }
+    await _writeIndex(assetName, cacheKey, file);
+    return _resolved[resolvedKey] = file;
+  }
+
+  /// Extracts [assetName] if needed and opens it as a memory-mapped [Model].
+  Future<Model> loadAsset(String assetName,
+      {String? cacheKey, ModelPrefetch prefetch = ModelPrefetch.none}) async {
+    final file = await extractAsset(assetName, cacheKey: cacheKey);
+    return open(file, prefetch: prefetch);
+  }
+
+  /// Decompresses [assetName] into the cache if needed and opens it as a
+  /// memory-mapped [Model]. See [extractCompressedAsset].
+  Future<Model> loadCompressedAsset(String assetName,
+      {String? cacheKey,
+      ModelPrefetch prefetch = ModelPrefetch.none,
+      void Function(DecompressionStats stats)? onDecompressed}) async {
+    final file = await extractCompressedAsset(assetName,
+        cacheKey: cacheKey, onDecompressed: onDecompressed);
+    return open(file, prefetch: prefetch);
+  }
+
+  /// Stores [bytes] under their content hash and returns the cached file.
+  ///
+  /// The hash is computed on a background isolate. Files are written to a
+  /// temporary name and renamed into place, so concurrent writers and
+  /// interrupted writes never expose a partial model.
+  Future<File> put(Uint8List bytes) async {
+    final file = fileFor(await _hashInBackground(bytes));
+    if (await file.exists() && await file.length() == bytes.length) {
+      return file;
+    }
+    return _writeAtomically(
+        file, (temp) => temp.writeAsBytes(bytes, flush: true));
+  }
+
+  /// Returns the cache file for the content hash [hash].
+  File fileFor(String hash) => File(p.join(directory.path, '$hash.tflite'));
+
+  /// Deletes every cached file.
+  Future<void> clear() async {
+    _resolved.clear();
+    if (await directory.exists()) {
+      await directory.delete(recursive: true);
+    }
+  }
+
+  /// Opens [file] as a memory-mapped [Model], warming it as per [prefetch].
+  static Model open(File file, {ModelPrefetch prefetch = ModelPrefetch.none}) {
+    if (prefetch != ModelPrefetch.none) {
+      ModelCache.prefetch(file, prefetch);
+    }
+    return Model.fromFile(file.path);
+  }
+
+  /// Warms the page cache for [file]. Returns false if the platform or the
+  /// loaded runtime library cannot honour [mode], as for
+  /// [ModelPrefetch.willNeed] with the helper library bundled for macOS.
+  static bool prefetch(File file, ModelPrefetch mode) {
+    if (mode == ModelPrefetch.none) {
+      return true;
+    }
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      if (mode == ModelPrefetch.prefault) {
+        _readThrough(file);
+        return true;
+      }
+      return false;
+    }
+    final prefault = mode == ModelPrefetch.prefault ? 1 : 0;
+    final path = file.path.toNativeUtf8();
+    try {
+      return runtime.prefetchFile(path.cast(), prefault) == 0;
+    } finally {
+      calloc.free(path);
+    }
+  }
+
+  /// Content hash used to name cached files: 64-bit FNV-1a of [bytes]
+  /// followed by their length.
+  static String contentHash(Uint8List bytes) {
+    var hash = 0xcbf29ce484222325;
+    for (var i = 0; i < bytes.length; i++) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+    final high = ((hash >> 32) & 0xffffffff).toRadixString(16).padLeft(8, '0');
+    final low = (hash & 0xffffffff).toRadixString(16).padLeft(8, '0');
+    return '$high$low-${bytes.length}';
+  }
+
+  File _indexFileFor(String assetName) =>
+      File(p.join(directory.path, '${Uri.encodeComponent(assetName)}.key'));
+
+  /// Returns the file recorded for [assetName] under [cacheKey], if any.
+  Future<File?> _readIndex(String assetName, String? cacheKey) async {
+    final indexFile = _indexFileFor(assetName);
+    if (cacheKey == null || !await indexFile.exists()) {
+      return null;
+    }
+    final lines = await indexFile.readAsLines();
+    if (lines.length != 2 || lines[0] != cacheKey) {
+      return null;
+    }
+    final file = fileFor(lines[1]);
+    return await file.exists() ? file : null;
+  }
+
+  Future<void> _writeIndex(
+      String assetName, String? cacheKey, File file) async {
+    if (cacheKey == null) {
+      return;
+    }
+    final entry = '$cacheKey\n${_hashOf(file)}';
+    await _writeAtomically(
+        _indexFileFor(assetName), (temp) => temp.writeAsString(entry));
+  }
+
+  // Kept static so the isolate closures capture nothing but their arguments.
+  static Future<String> _hashInBackground(Uint8List bytes) {
+    return Isolate.run(() => contentHash(bytes));
+  }
+
+  // Hashes [compressed] and decompresses it into [directoryPath] unless the
+  // file for its hash already exists; [tempId] keeps the temporary name
+  // unique within this process.
+  static Future<_Extraction> _decompressInBackground(Uint8List compressed,
+      String directoryPath, int tempId, int chunkSize) {
+    return Isolate.run(() {
+      final hash = contentHash(compressed);
+      final targetPath = p.join(directoryPath, '$hash.tflite');
+      if (File(targetPath).existsSync()) {
+        return _Extraction(hash, null);
+      }
+      Directory(directoryPath).createSync(recursive: true);
+      final tempPath = '$targetPath.$pid.$tempId.tmp';
+      return _Extraction(
+          hash, _decompressTo(compressed, tempPath, targetPath, chunkSize));
+    });
+  }
+
+  static DecompressionStats _decompressTo(
+      Uint8List compressed, String tempPath, String targetPath, int chunkSize) {
+    final stopwatch = Stopwatch()..start();
+    final Converter<List<int>, List<int>>? decoder;
+    if (ZstdDecoder.isZstd(compressed)) {
+      decoder = null;
+    } else if (compressed.length >= 2 &&
+        compressed[0] == 0x1f &&
+        compressed[1] == 0x8b) {
+      decoder = GZipCodec().decoder;
+    } else if (compressed.length >= 2 &&
+        (compressed[0] & 0x0f) == 8 &&
+        ((compressed[0] << 8) | compressed[1]) % 31 == 0) {
+      decoder = ZLibDecoder();
+    } else {
+      decoder = ZLibDecoder(raw: true);
+    }
+
+    final temp = File(tempPath);
+    final output = temp.openSync(mode: FileMode.writeOnly);
+    var written = 0;
+    void write(List<int> chunk) {
+      output.writeFromSync(chunk);
+      written += chunk.length;
+    }
+
+    try {
+      if (decoder == null) {
+        // Writes each block as it is decoded.
+        ZstdDecoder.decode(compressed, write);
+      } else {
+        final sink = decoder.startChunkedConversion(_CallbackSink(write));
+        for (var start = 0; start < compressed.length; start += chunkSize) {
+          final end = start + chunkSize < compressed.length
+              ? start + chunkSize
+              : compressed.length;
+          sink.add(Uint8List.sublistView(compressed, start, end));
+        }
+        sink.close();
+      }
+      output.flushSync();
+    } catch (_) {
+      output.closeSync();
+      temp.deleteSync();
+      rethrow;
+    }
+    output.closeSync();
+    try {
+      temp.renameSync(targetPath);
+    } on FileSystemException {
+      temp.deleteSync();
+      if (!File(targetPath).existsSync()) {
+        rethrow;
+      }
+    }
+    stopwatch.stop();
+    return DecompressionStats(
+        compressed.length, written, stopwatch.elapsedMicroseconds);
+  }
+
+  static String _hashOf(File file) => p.basenameWithoutExtension(file.path);
+
+  Future<File> _writeAtomically(
+      File target, Future<File> Function(File temp) write) async {
+    await directory.create(recursive: true);
+    final temp = File('${target.path}.$pid.${_tempCounter++}.tmp');
+    try {
+      await write(temp);
+      return await temp.rename(target.path);
+    } catch (_) {
+      if (await temp.exists()) {
+        await temp.delete();
+      }
+      // Another writer may have won the race, e.g. where rename cannot
+      // replace an existing file.
+      if (await target.exists()) {
+        return target;
+      }
+      rethrow;
+    }
+  }
+
+  static void _readThrough(File file) {
+    final raf = file.openSync();
+    try {
+      final chunk = Uint8List(1 << 20);
+      while (raf.readIntoSync(chunk) == chunk.length) {}
+    } finally {
+      raf.closeSync();
+    }
+  }
+}
+
+/// Content hash of an extracted asset and, if it was decompressed, the
+/// stats of that run.
+class _Extraction {
+  _Extraction(this.hash, this.stats);
+
+  final String hash;
+  final DecompressionStats? stats;
+}
+
+/// [Sink] forwarding each chunk to a callback.
+class _CallbackSink implements Sink<List<int>> {
+  _CallbackSink(this._onChunk);
+
+  final void Function(List<int> chunk) _onChunk;
+
+  @override
+  void add(List<int> data) => _onChunk(data);
+
+  @override
+  void close() {}
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+import 'tensor.dart';
+
+/// Typed lists backed by native memory.
+///
+/// Native code can read and write these buffers in place, so
+/// [Interpreter.runForMultipleInputs] copies them in and out of tensors
+/// inside a single native call instead of going through Dart copies. The
+/// memory is released when the list is garbage collected.
+///
+/// Only the lists returned here are recognised; views created from them with
+/// `sublistView` are treated as ordinary Dart buffers.
+abstract final class NativeBuffer {
+  static final Expando<Pointer<Void>> _pointers = Expando('NativeBuffer');
+
+  /// Allocates a zeroed [Float32List] of [length] elements.
+  static Float32List float32(int length) =>
+      _allocate(TensorType.float32, length) as Float32List;
+
+  /// Allocates a zeroed [Float64List] of [length] elements.
+  static Float64List float64(int length) =>
+      _allocate(TensorType.float64, length) as Float64List;
+
+  /// Allocates a zeroed [Int64List] of [length] elements.
+  static Int64List int64(int length) =>
+      _allocate(TensorType.int64, length) as Int64List;
+
+  /// Allocates a zeroed [Int32List] of [length] elements.
+  static Int32List int32(int length) =>
+      _allocate(TensorType.int32, length) as Int32List;
+
+  /// Allocates a zeroed [Int16List] of [length] elements.
+  static Int16List int16(int length) =>
+      _allocate(TensorType.int16, length) as Int16List;
+
+  /// Allocates a zeroed [Int8List] of [length] elements.
+  static Int8List int8(int length) =>
+      _allocate(TensorType.int8, length) as Int8List;
+
+  /// Allocates a zeroed [Uint8List] of [length] elements.
+  static Uint8List uint8(int length) =>
+      _allocate(TensorType.uint8, length) as Uint8List;
+
+  /// Allocates a buffer with the typed list type and byte size of [tensor],
+  /// matching [Tensor.typedData].
+  static TypedData forTensor(Tensor tensor) {
+    final type = tensor.type;
+    return _allocate(type, tensor.numBytes() ~/ _elementSize(type));
+  }
+
+  /// Returns the native address of [data], or null if it was not allocated
+  /// by [NativeBuffer].
+  static Pointer<Void>? addressOf(TypedData data) => _pointers[data];
+
+  static TypedData _allocate(TensorType type, int length) {
+    if (length <= 0) {
+      throw ArgumentError.value(length, 'length', 'must be positive');
+    }
+    final ptr = calloc<Uint8>(length * _elementSize(type));
+    final finalizer = calloc.nativeFree;
+    final TypedData list;
+    switch (type) {
+      case TensorType.float32:
+        list = ptr.cast<Float>().asTypedList(length, finalizer: finalizer);
+      case TensorType.float64:
+        list = ptr.cast<Double>().asTypedList(length, finalizer: finalizer);
+      case TensorType.int64:
+        list = ptr.cast<Int64>().asTypedList(length, finalizer: finalizer);
+      case TensorType.uint64:
+        list = ptr.cast<Uint64>().asTypedList(length, finalizer: finalizer);
+      case TensorType.int32:
+        list = ptr.cast<Int32>().asTypedList(length, finalizer: finalizer);
+      case TensorType.uint32:
+        list = ptr.cast<Uint32>().asTypedList(length, finalizer: finalizer);
+      case TensorType.int16:
+        list = ptr.cast<Int16>().asTypedList(length, finalizer: finalizer);
+      case TensorType.uint16:
+      case TensorType.float16:
+        list = ptr.cast<Uint16>().asTypedList(length, finalizer: finalizer);
+      case TensorType.int8:
+        list = ptr.cast<Int8>().asTypedList(length, finalizer: finalizer);
+      default:
+        list = ptr.asTypedList(length, finalizer: finalizer);
+    }
+    _pointers[list] = ptr.cast();
+    return list;
+  }
+
+  static int _elementSize(TensorType type) {
+    switch (type) {
+      case TensorType.float64:
+      case TensorType.int64:
+      case TensorType.uint64:
+        return 8;
+      case TensorType.float32:
+      case TensorType.int32:
+      case TensorType.uint32:
+        return 4;
+      case TensorType.int16:
+      case TensorType.uint16:
+      case TensorType.float16:
+        return 2;
+      default:
+        return 1;
+    }
+  }
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:collection';
+
+import 'package:flutter/foundation.dart';
+import 'package:quiver/check.dart';
+
+import 'interpreter.dart';
+import 'interpreter_options.dart';
+import 'model.dart';
+import 'tensor_view.dart';
+
+/// Pads one axis of one input up to the nearest of a fixed set of sizes.
+///
+/// With buckets of 16, 32, 64 and 128 along the sequence axis, any length
+/// up to 128 maps to one of four shapes, so [ShapeCachedInterpreter] only
+/// ever allocates four interpreters.
+class InputBucketing {
+  InputBucketing({
+    required this.inputIndex,
+    required this.axis,
+    required List<int> buckets,
+    this.padValue = 0,
+    this.maskInputIndex,
+    this.croppedOutputAxes = const <int, int>{},
+  }) : buckets = List.unmodifiable(List.of(buckets)..sort()) {
+    checkArgument(buckets.isNotEmpty && buckets.every((size) => size > 0),
+        message: 'Buckets must be positive sizes');
+  }
+
+  /// Model input whose [axis] is padded.
+  final int inputIndex;
+
+  /// Axis of the input that is padded.
+  final int axis;
+
+  /// Allowed sizes of [axis], in increasing order.
+  final List<int> buckets;
+
+  /// Value written into the padding.
+  final num padValue;
+
+  /// Model input filled with the validity mask of the padded axis: 1 for
+  /// positions holding caller data, 0 for padding. Its shape is the padded
+  /// shape of [inputIndex]. Callers pass null for this input. Rules padding
+  /// several axes of one input may share a mask, which is then 1 only where
+  /// every axis holds caller data.
+  final int? maskInputIndex;
+
+  /// Output axes cropped back to the unpadded size, keyed by output index.
+  final Map<int, int> croppedOutputAxes;
+
+  /// Returns the smallest bucket holding [size].
+  ///
+  /// Throws [ArgumentError] if [size] exceeds the largest bucket.
+  int bucketFor(int size) {
+    for (final bucket in buckets) {
+      if (bucket >= size) {
+        return bucket;
+      }
+    }
+    throw ArgumentError.value(
+        size, 'size', 'Exceeds the largest bucket ${buckets.last}');
+  }
+}
+
+/// Runs a model on inputs of varying shape without re-planning its tensors.
+///
+/// One allocated interpreter is cached per distinct set of input shapes, so
+/// a shape seen before runs with a plain invoke instead of a resize and
+/// [Interpreter.allocateTensors]. With [InputBucketing] rules, inputs are
+/// first padded up to a bucket size, which bounds the number of shapes; the
+/// padding mask can be fed to the model and padded outputs are cropped back
+/// to the caller's size. The least recently used interpreter is closed once
+/// more than [maxCachedShapes] are cached.
+class ShapeCachedInterpreter {
+  ShapeCachedInterpreter._(this._model, this._createOptions, this.bucketing,
+      this.maxCachedShapes);
+
+  /// Creates a shape-keyed cache of interpreters for [model].
+  ///
+  /// Interpreters get options from [createOptions], or default options when
+  /// omitted. The cache holds its own reference to [model], so the caller
+  /// may delete it right away.
+  ///
+  /// Several [bucketing] rules may pad different axes of one input, but
+  /// not the same axis twice.
+  static ShapeCachedInterpreter create(
+    Model model, {
+    List<InputBucketing> bucketing = const <InputBucketing>[],
+    int maxCachedShapes = 8,
+    InterpreterOptions Function()? createOptions,
+  }) {
+    checkArgument(maxCachedShapes > 0,
+        message: 'maxCachedShapes must be positive');
+    final padded = <String>{};
+    for (final rule in bucketing) {
+      checkArgument(padded.add('${rule.inputIndex}:${rule.axis}'),
+          message: 'Axis ${rule.axis} of input ${rule.inputIndex} is '
+              'bucketed twice');
+    }
+    model.retain();
+    return ShapeCachedInterpreter._(model,
+        createOptions ?? InterpreterOptions.new, bucketing, maxCachedShapes);
+  }
+
+  final Model _model;
+  final InterpreterOptions Function() _createOptions;
+
+  /// Padding rules applied to the inputs.
+  final List<InputBucketing> bucketing;
+
+  /// Maximum number of interpreters kept allocated.
+  final int maxCachedShapes;
+
+  // Insertion order doubles as recency order: hits are moved to the end.
+  final LinkedHashMap<String, _CachedShape> _cache =
+      LinkedHashMap<String, _CachedShape>();
+  bool _closed = false;
+  int _hits = 0;
+  int _misses = 0;
+
+  /// Number of runs that reused an allocated interpreter.
+  int get hits => _hits;
+
+  /// Number of runs that had to create and allocate an interpreter.
+  int get misses => _misses;
+
+  /// Number of interpreters currently cached.
+  int get cachedShapes => _cache.length;
+
+  /// Runs the model and returns a contiguous copy of every output.
+  ///
+  /// [inputs] holds one view per model input, or null for inputs filled
+  /// with a bucketing mask. Outputs listed in
+  /// [InputBucketing.croppedOutputAxes] are cropped to the unpadded size.
+  List<TensorView> run(List<TensorView?> inputs) {
+    checkState(!_closed, message: 'ShapeCachedInterpreter already closed.');
+    final shapes = [for (final input in inputs) input?.shape];
+    final sizes = <InputBucketing, int>{};
+    for (final rule in bucketing) {
+      final shape = List<int>.of(_inputShape(shapes, rule.inputIndex));
+      RangeError.checkValidIndex(rule.axis, shape, 'axis', shape.length);
+      sizes[rule] = shape[rule.axis];
+      shape[rule.axis] = rule.bucketFor(shape[rule.axis]);
+      shapes[rule.inputIndex] = shape;
+    }
+    for (final rule in bucketing) {
+      final maskIndex = rule.maskInputIndex;
+      if (maskIndex != null) {
+        while (shapes.length <= maskIndex) {
+          shapes.add(null);
+        }
+        shapes[maskIndex] = shapes[rule.inputIndex];
+      }
+    }
+    for (var i = 0; i < shapes.length; i++) {
+      checkArgument(shapes[i] != null, message: 'Missing input $i');
+    }
+
+    final interpreter = _interpreterFor(shapes.cast<List<int>>());
+    final tensors = interpreter.getInputTensors();
+    for (var i = 0; i < inputs.length; i++) {
+      final input = inputs[i];
+      if (input != null) {
+        final tensor = tensors[i];
+        checkArgument(input.type == tensor.type,
+            message: 'Input of type ${input.type} does not match tensor type '
+                '${tensor.type}');
+        pad(input, tensor.typedData as List<num>, tensor.shape,
+            _padValueFor(i));
+      }
+    }
+    final masks = <int, Map<int, int>>{};
+    for (final rule in bucketing) {
+      final maskIndex = rule.maskInputIndex;
+      if (maskIndex != null) {
+        (masks[maskIndex] ??= <int, int>{})[rule.axis] = sizes[rule]!;
+      }
+    }
+    for (final entry in masks.entries) {
+      final tensor = tensors[entry.key];
+      writeMask(tensor.typedData as List<num>, tensor.shape, entry.value);
+    }
+    interpreter.invoke();
+
+    final outputs = [
+      for (final tensor in interpreter.getOutputTensors()) tensor.view
+    ];
+    return crop(outputs, sizes);
+  }
+
+  /// Copies [input] into the leading corner of [target], laid out row-major
+  /// with [shape], and fills the rest with [padValue].
+  ///
+  /// Every axis of [shape] must be at least as large as that of [input].
+  @visibleForTesting
+  static void pad(
+      TensorView input, List<num> target, List<int> shape, num padValue) {
+    checkArgument(input.rank == shape.length,
+        message: 'Input of rank ${input.rank} does not match shape $shape');
+    for (var d = 0; d < shape.length; d++) {
+      checkArgument(input.shape[d] <= shape[d],
+          message: 'Input of shape ${input.shape} exceeds shape $shape');
+    }
+    final source = input.isContiguous ? input : input.copy();
+    final sourceData = source.data as List<num>;
+    if (_sameShape(source.shape, shape)) {
+      target.setRange(0, target.length, sourceData, source.offset);
+      return;
+    }
+    target.fillRange(0, target.length,
+        target is List<double> ? padValue.toDouble() : padValue.toInt());
+    if (source.length == 0) {
+      return;
+    }
+
+    // Copy the source one row of the last axis at a time, stepping the row
+    // index through the other axes and placing it with the padded strides.
+    final rank = shape.length;
+    final row = source.shape[rank - 1];
+    final strides = List<int>.filled(rank, 1);
+    for (var d = rank - 2; d >= 0; d--) {
+      strides[d] = strides[d + 1] * shape[d + 1];
+    }
+    final index = List<int>.filled(rank - 1, 0);
+    var from = source.offset;
+    for (var r = source.length ~/ row; r > 0; r--) {
+      var to = 0;
+      for (var d = 0; d < rank - 1; d++) {
+        to += index[d] * strides[d];
+      }
+      target.setRange(to, to + row, sourceData, from);
+      from += row;
+      for (var d = rank - 2; d >= 0; d--) {
+        if (++index[d] < source.shape[d]) {
+          break;
+        }
+        index[d] = 0;
+      }
+    }
+  }
+
+  /// Fills [target], laid out row-major with [shape], with 1 where the
+  /// index along every axis of [sizes] is below its size and 0 elsewhere.
+  @visibleForTesting
+  static void writeMask(
+      List<num> target, List<int> shape, Map<int, int> sizes) {
+    final inner = <int, int>{};
+    for (final axis in sizes.keys) {
+      var size = 1;
+      for (var d = axis + 1; d < shape.length; d++) {
+        size *= shape[d];
+      }
+      inner[axis] = size;
+    }
+    final isFloat = target is List<double>;
+    final one = isFloat ? 1.0 : 1;
+    final zero = isFloat ? 0.0 : 0;
+    for (var n = 0; n < target.length; n++) {
+      var valid = true;
+      for (final entry in sizes.entries) {
+        if ((n ~/ inner[entry.key]!) % shape[entry.key] >= entry.value) {
+          valid = false;
+          break;
+        }
+      }
+      target[n] = valid ? one : zero;
+    }
+  }
+
+  /// Crops [outputs] along the [InputBucketing.croppedOutputAxes] of each
+  /// rule in [sizes] to the unpadded size recorded for it, and returns a
+  /// contiguous copy of every output.
+  @visibleForTesting
+  static List<TensorView> crop(
+      List<TensorView> outputs, Map<InputBucketing, int> sizes) {
+    final cropped = List.of(outputs);
+    for (final entry in sizes.entries) {
+      for (final axis in entry.key.croppedOutputAxes.entries) {
+        cropped[axis.key] = cropped[axis.key].slice(axis.value, 0, entry.value);
+      }
+    }
+    return [for (final output in cropped) output.copy()];
+  }
+
+  /// Closes every cached interpreter.
+  void close() {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    for (final cached in _cache.values) {
+      cached.close();
+    }
+    _cache.clear();
+    _model.release();
+  }
+
+  Interpreter _interpreterFor(List<List<int>> shapes) {
+    final key = shapes.map((shape) => shape.join('x')).join(',');
+    final cached = _cache.remove(key);
+    if (cached != null) {
+      _hits++;
+      _cache[key] = cached;
+      return cached.interpreter;
+    }
+    _misses++;
+    final options = _createOptions();
+    final Interpreter interpreter;
+    try {
+      interpreter = Interpreter.fromModel(_model, options: options);
+    } catch (_) {
+      options.delete();
+      rethrow;
+    }
+    final entry = _CachedShape(interpreter, options);
+    try {
+      final tensors = interpreter.getInputTensors();
+      checkArgument(shapes.length == tensors.length,
+          message: 'Got ${shapes.length} inputs for a model with '
+              '${tensors.length} inputs');
+      for (var i = 0; i < shapes.length; i++) {
+        if (!_sameShape(tensors[i].shape, shapes[i])) {
+          interpreter.resizeInputTensor(i, shapes[i]);
+        }
+      }
+      interpreter.allocateTensors();
+    } catch (_) {
+      entry.close();
+      rethrow;
+    }
+    if (_cache.length >= maxCachedShapes) {
+      _cache.remove(_cache.keys.first)!.close();
+    }
+    _cache[key] = entry;
+    return interpreter;
+  }
+
+  num _padValueFor(int inputIndex) {
+    for (final rule in bucketing) {
+      if (rule.inputIndex == inputIndex) {
+        return rule.padValue;
+      }
+    }
+    return 0;
+  }
+
+  static List<int> _inputShape(List<List<int>?> shapes, int index) {
+    checkArgument(index < shapes.length && shapes[index] != null,
+        message: 'Bucketed input $index is missing');
+    return shapes[index]!;
+  }
+
+  static bool _sameShape(List<int> a, List<int> b) {
+    if (a.length != b.length) {
+      return false;
+    }
+    for (var i = 0; i < a.length; i++) {
+      if (a[i] != b[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+class _CachedShape {
+  _CachedShape(this.interpreter, this.options);
+
+  final Interpreter interpreter;
+  final InterpreterOptions options;
+
+  void close() {
+    interpreter.close();
+    options.delete();
+  }
+}
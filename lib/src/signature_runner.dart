@@ -0,0 +1,209 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+import 'package:quiver/check.dart';
+import 'package:flutter_litert/src/bindings/bindings.dart';
+import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
+
+import 'ffi/helper.dart';
+import 'tensor.dart';
+
+/// Runs inference on one signature (entry point) of a model.
+///
+/// Signature runners are obtained with [Interpreter.getSignatureRunner] and
+/// share the interpreter's weights, so a model exporting several entry
+/// points (for example `encode` and `decode`, or `init` and `step`) needs a
+/// single interpreter. Inputs and outputs are addressed by name; the
+/// returned [Tensor]s are cached and their [Tensor.typedData] aliases tensor
+/// memory, so they can be filled and read without copies.
+///
+/// Each signature is resized and allocated independently. A runner is
+/// deleted together with its interpreter.
+class SignatureRunner {
+  final Pointer<TfLiteSignatureRunner> _runner;
+  final void Function(bool reallocated) _onTensorsChanged;
+  bool _deleted = false;
+  bool _allocated = false;
+
+  /// Signature key of this runner.
+  final String key;
+
+  List<String>? _inputNames;
+  List<String>? _outputNames;
+
+  // Native copies of the names, kept for the lifetime of the runner because
+  // every resize and tensor lookup needs them.
+  final Map<String, Pointer<Char>> _nativeNames = <String, Pointer<Char>>{};
+
+  final Map<String, Tensor> _inputTensors = <String, Tensor>{};
+  final Map<String, Tensor> _outputTensors = <String, Tensor>{};
+
+  /// Wraps [runner] for the signature [key].
+  ///
+  /// Used by [Interpreter.getSignatureRunner], which passes a callback run
+  /// whenever this runner may have moved tensor memory of the interpreter:
+  /// with `reallocated` set after a resize or allocation, and unset after an
+  /// invoke, which may only reallocate dynamic outputs.
+  SignatureRunner(this._runner, this.key, this._onTensorsChanged) {
+    checkArgument(isNotNull(_runner),
+        message: 'No signature runner for key $key');
+  }
+
+  /// Names of the signature inputs, in signature order.
+  List<String> get inputNames {
+    return _inputNames ??= List.unmodifiable(List.generate(
+        tfliteBinding.TfLiteSignatureRunnerGetInputCount(_runner),
+        (i) => _string(
+            tfliteBinding.TfLiteSignatureRunnerGetInputName(_runner, i))));
+  }
+
+  /// Names of the signature outputs, in signature order.
+  List<String> get outputNames {
+    return _outputNames ??= List.unmodifiable(List.generate(
+        tfliteBinding.TfLiteSignatureRunnerGetOutputCount(_runner),
+        (i) => _string(
+            tfliteBinding.TfLiteSignatureRunnerGetOutputName(_runner, i))));
+  }
+
+  bool get isAllocated => _allocated;
+
+  bool get isDeleted => _deleted;
+
+  /// Returns the input tensor named [name].
+  ///
+  /// Throws [ArgumentError] if the signature has no such input.
+  Tensor getInputTensor(String name) {
+    checkState(!_deleted, message: 'SignatureRunner already deleted.');
+    final cached = _inputTensors[name];
+    if (cached != null) {
+      return cached;
+    }
+    _checkName(name, inputNames, 'input');
+    final tensor = tfliteBinding.TfLiteSignatureRunnerGetInputTensor(
+        _runner, _nativeName(name));
+    checkArgument(isNotNull(tensor), message: 'Input $name has no tensor');
+    return _inputTensors[name] = Tensor(tensor);
+  }
+
+  /// Returns the output tensor named [name].
+  ///
+  /// Throws [ArgumentError] if the signature has no such output.
+  Tensor getOutputTensor(String name) {
+    checkState(!_deleted, message: 'SignatureRunner already deleted.');
+    final cached = _outputTensors[name];
+    if (cached != null) {
+      return cached;
+    }
+    _checkName(name, outputNames, 'output');
+    final tensor = tfliteBinding.TfLiteSignatureRunnerGetOutputTensor(
+        _runner, _nativeName(name));
+    checkArgument(isNotNull(tensor), message: 'Output $name has no tensor');
+    return _outputTensors[name] = Tensor(tensor);
+  }
+
+  /// Resizes the input named [name]. [allocateTensors] must be called again
+  /// afterward.
+  void resizeInputTensor(String name, List<int> shape) {
+    checkState(!_deleted, message: 'SignatureRunner already deleted.');
+    _checkName(name, inputNames, 'input');
+    final dimensionSize = shape.length;
+    final dimensions = calloc<Int>(dimensionSize);
+    dimensions.cast<Int32>().asTypedList(dimensionSize).setAll(0, shape);
+    final status = tfliteBinding.TfLiteSignatureRunnerResizeInputTensor(
+        _runner, _nativeName(name), dimensions, dimensionSize);
+    calloc.free(dimensions);
+    checkState(status == TfLiteStatus.kTfLiteOk,
+        message: 'Unable to resize input $name to $shape');
+    _allocated = false;
+    _onTensorsChanged(true);
+  }
+
+  /// Updates allocations for all tensors of this signature.
+  void allocateTensors() {
+    checkState(!_deleted, message: 'SignatureRunner already deleted.');
+    checkState(
+        tfliteBinding.TfLiteSignatureRunnerAllocateTensors(_runner) ==
+            TfLiteStatus.kTfLiteOk,
+        message: 'Unable to allocate tensors for signature $key');
+    _allocated = true;
+    _onTensorsChanged(true);
+  }
+
+  /// Runs the signature on the current contents of its input tensors.
+  void invoke() {
+    checkState(!_deleted, message: 'SignatureRunner already deleted.');
+    checkState(_allocated, message: 'SignatureRunner not allocated.');
+    checkState(
+        tfliteBinding.TfLiteSignatureRunnerInvoke(_runner) ==
+            TfLiteStatus.kTfLiteOk,
+        message: 'Unable to invoke signature $key');
+    _onTensorsChanged(false);
+  }
+
+  /// Copies [inputs] into the named inputs, runs the signature and copies
+  /// the named [outputs] out.
+  ///
+  /// Inputs are accepted in every form supported by [Tensor.setTo]. Inputs
+  /// whose shape differs from the tensor are resized first, and tensors are
+  /// allocated when needed.
+  void run(Map<String, Object> inputs, Map<String, Object> outputs) {
+    for (final entry in inputs.entries) {
+      final newShape =
+          getInputTensor(entry.key).getInputShapeIfDifferent(entry.value);
+      if (newShape != null) {
+        resizeInputTensor(entry.key, newShape);
+      }
+    }
+    if (!_allocated) {
+      allocateTensors();
+    }
+    for (final entry in inputs.entries) {
+      getInputTensor(entry.key).setTo(entry.value);
+    }
+    invoke();
+    for (final entry in outputs.entries) {
+      getOutputTensor(entry.key).copyTo(entry.value);
+    }
+  }
+
+  /// Deletes the runner. Called by [Interpreter.close].
+  void delete() {
+    checkState(!_deleted, message: 'SignatureRunner already deleted.');
+    tfliteBinding.TfLiteSignatureRunnerDelete(_runner);
+    for (final name in _nativeNames.values) {
+      calloc.free(name);
+    }
+    _nativeNames.clear();
+    _inputTensors.clear();
+    _outputTensors.clear();
+    _deleted = true;
+  }
+
+  Pointer<Char> _nativeName(String name) =>
+      _nativeNames[name] ??= name.toNativeUtf8().cast<Char>();
+
+  static String _string(Pointer<Char> ptr) => ptr.cast<Utf8>().toDartString();
+
+  static void _checkName(String name, List<String> names, String kind) {
+    if (!names.contains(name)) {
+      throw ArgumentError(
+          "Signature error: '$name' is not a valid $kind name. Valid names are $names");
+    }
+  }
+}
@@ -20,12 +20,14 @@ import 'dart:typed_data';
 import 'package:ffi/ffi.dart';
 import 'package:quiver/check.dart';
 import 'package:flutter_litert/src/bindings/bindings.dart';
+import 'package:flutter_litert/src/bindings/runtime_bindings.dart';
 import 'package:flutter_litert/src/bindings/tensorflow_lite_bindings_generated.dart';
 import 'package:flutter_litert/src/util/byte_conversion_utils.dart';
 import 'package:flutter/foundation.dart';
 
 import 'ffi/helper.dart';
 import 'quanitzation_params.dart';
+import 'tensor_view.dart';
 import 'util/list_shape_extension.dart';
 
 export 'bindings/tensorflow_lite_bindings_generated.dart' show TfLiteType;
@@ -34,34 +36,173 @@ export 'bindings/tensorflow_lite_bindings_generated.dart' show TfLiteType;
 class Tensor {
   final Pointer<TfLiteTensor> _tensor;
 
+  // Name and type never change, so they are cached on first use.
+  String? _name;
+  TensorType? _type;
+
+  // Shape, size, data and quantization change with resizing and allocation.
+  // They are only cached when filled by [snapshotMetadata] and are dropped
+  // by [clearMetadata].
+  List<int>? _shape;
+  int? _byteSize;
+  Pointer<Void>? _dataPointer;
+  QuantizationParams? _params;
+
   Tensor(this._tensor) {
     ArgumentError.checkNotNull(_tensor);
   }
 
   /// Name of the tensor element.
-  String get name =>
+  String get name => _name ??=
       tfliteBinding.TfLiteTensorName(_tensor).cast<Utf8>().toDartString();
 
   /// Data type of the tensor element.
-  TensorType get type => TensorType.fromValue(
+  TensorType get type => _type ??= TensorType.fromValue(
         tfliteBinding.TfLiteTensorType(_tensor),
       );
 
   /// Dimensions of the tensor.
-  List<int> get shape => List.generate(
-      tfliteBinding.TfLiteTensorNumDims(_tensor),
-      (i) => tfliteBinding.TfLiteTensorDim(_tensor, i));
+  List<int> get shape {
+    final cached = _shape;
+    if (cached != null) {
+      return List.of(cached);
+    }
+    return List.generate(tfliteBinding.TfLiteTensorNumDims(_tensor),
+        (i) => tfliteBinding.TfLiteTensorDim(_tensor, i));
+  }
+
+  Pointer<Void> get _data =>
+      _dataPointer ?? tfliteBinding.TfLiteTensorData(_tensor);
+
+  int get _size => _byteSize ?? tfliteBinding.TfLiteTensorByteSize(_tensor);
+
+  /// Fills the cached metadata of [inputs] and [outputs], the input and
+  /// output tensors of [interpreter], from a single native snapshot.
+  ///
+  /// Used by [Interpreter] after tensors are allocated. Returns false, leaving
+  /// the tensors to query TFLite on every access, if the runtime helper
+  /// library is unavailable.
+  static bool snapshotMetadata(Pointer<TfLiteInterpreter> interpreter,
+      List<Tensor> inputs, List<Tensor> outputs) {
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      return false;
+    }
+    final inputInfos = calloc<TfLiteFlutterTensorInfo>(inputs.length + 1);
+    final outputInfos = calloc<TfLiteFlutterTensorInfo>(outputs.length + 1);
+    try {
+      final status = runtime.getTensorInfos(interpreter, inputInfos,
+          inputs.length, outputInfos, outputs.length);
+      if (status != TfLiteStatus.kTfLiteOk) {
+        return false;
+      }
+      for (var i = 0; i < inputs.length; i++) {
+        inputs[i]._applyInfo(inputInfos[i]);
+      }
+      for (var i = 0; i < outputs.length; i++) {
+        outputs[i]._applyInfo(outputInfos[i]);
+      }
+      return true;
+    } finally {
+      calloc.free(inputInfos);
+      calloc.free(outputInfos);
+    }
+  }
+
+  /// Whether an invoke may reshape or move any of [tensors]: it is allocated
+  /// dynamically, or still has no buffer after allocation because it
+  /// follows a dynamically shaped op.
+  static bool anyDynamic(Iterable<Tensor> tensors) {
+    for (final tensor in tensors) {
+      if (tensor._data == nullptr ||
+          tensor._tensor.ref.allocation_type ==
+              TfLiteAllocationType.kTfLiteDynamic) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Drops the metadata cached by [snapshotMetadata] from [tensors].
+  static void clearMetadata(Iterable<Tensor> tensors) {
+    for (final tensor in tensors) {
+      tensor._shape = null;
+      tensor._byteSize = null;
+      tensor._dataPointer = null;
+      tensor._params = null;
+    }
+  }
+
+  void _applyInfo(TfLiteFlutterTensorInfo info) {
+    if (info.tensor.address != _tensor.address) {
+      return;
+    }
+    _name ??= info.name.cast<Utf8>().toDartString();
+    _type ??= TensorType.fromValue(info.type);
+    final numDims = info.numDims;
+    _shape = numDims <= tfliteFlutterMaxDims
+        ? List.unmodifiable(List.generate(numDims, (i) => info.dims[i]))
+        : null;
+    _byteSize = info.byteSize;
+    _dataPointer = info.data;
+    _params = QuantizationParams(info.scale, info.zeroPoint);
+  }
 
   /// Underlying data buffer as bytes.
   Uint8List get data {
-    final data = cast<Uint8>(tfliteBinding.TfLiteTensorData(_tensor));
-    return data
-        .asTypedList(tfliteBinding.TfLiteTensorByteSize(_tensor))
-        .asUnmodifiableView();
+    final data = cast<Uint8>(_data);
+    return data.asTypedList(_size).asUnmodifiableView();
   }
 
+  /// Typed view over the tensor's data buffer, matching [type].
+  ///
+  /// The view aliases the native tensor memory, so inputs can be filled in
+  /// place without any intermediate copy. It is only valid until the next
+  /// [Interpreter.resizeInputTensor] or [Interpreter.allocateTensors] call.
+  ///
+  /// Types without a Dart typed list counterpart are exposed as [Uint8List].
+  TypedData get typedData {
+    final ptr = _data;
+    checkState(isNotNull(ptr), message: 'Tensor data is null.');
+    final size = _size;
+    switch (type) {
+      case TensorType.float32:
+        return ptr.cast<Float>().asTypedList(size ~/ 4);
+      case TensorType.float64:
+        return ptr.cast<Double>().asTypedList(size ~/ 8);
+      case TensorType.int64:
+        return ptr.cast<Int64>().asTypedList(size ~/ 8);
+      case TensorType.uint64:
+        return ptr.cast<Uint64>().asTypedList(size ~/ 8);
+      case TensorType.int32:
+        return ptr.cast<Int32>().asTypedList(size ~/ 4);
+      case TensorType.uint32:
+        return ptr.cast<Uint32>().asTypedList(size ~/ 4);
+      case TensorType.int16:
+        return ptr.cast<Int16>().asTypedList(size ~/ 2);
+      case TensorType.uint16:
+      case TensorType.float16:
+        return ptr.cast<Uint16>().asTypedList(size ~/ 2);
+      case TensorType.int8:
+        return ptr.cast<Int8>().asTypedList(size);
+      default:
+        return ptr.cast<Uint8>().asTypedList(size);
+    }
+  }
+
+  /// Zero-copy [TensorView] over the tensor memory with the tensor's shape.
+  ///
+  /// Like [typedData], the view aliases native memory: it reflects the next
+  /// inference and is invalidated by resizing or reallocating tensors. Use
+  /// [TensorView.copy] to keep a snapshot.
+  TensorView get view => TensorView(typedData, shape, type: type);
+
   /// Quantization Params associated with the model, [only Android]
   QuantizationParams get params {
+    final cached = _params;
+    if (cached != null) {
+      return cached;
+    }
     final ref = tfliteBinding.TfLiteTensorQuantizationParams(_tensor);
     return QuantizationParams(ref.scale, ref.zero_point);
   }
@@ -70,9 +211,9 @@ class Tensor {
   ///
   /// The size must match the size of the tensor.
   set data(Uint8List bytes) {
-    final tensorByteSize = tfliteBinding.TfLiteTensorByteSize(_tensor);
+    final tensorByteSize = _size;
     checkArgument(tensorByteSize == bytes.length);
-    final data = cast<Uint8>(tfliteBinding.TfLiteTensorData(_tensor));
+    final data = cast<Uint8>(_data);
     checkState(isNotNull(data), message: 'Tensor data is null.');
     final externalTypedData = data.asTypedList(tensorByteSize);
     externalTypedData.setRange(0, tensorByteSize, bytes);
@@ -80,12 +221,12 @@ class Tensor {
 
   /// Returns number of dimensions
   int numDimensions() {
-    return tfliteBinding.TfLiteTensorNumDims(_tensor);
+    return _shape?.length ?? tfliteBinding.TfLiteTensorNumDims(_tensor);
   }
 
   /// Returns the size, in bytes, of the tensor data.
   int numBytes() {
-    return tfliteBinding.TfLiteTensorByteSize(_tensor);
+    return _size;
   }
 
   /// Returns the number of elements in a flattened (1-D) view of the tensor.
@@ -133,7 +274,7 @@ class Tensor {
       throw ArgumentError(
           'Mismatched lengths ${shape[dim]} and $len in dimension $dim');
     }
-    for (var i = 0; i < len; ++i) {
+    if (len > 0) {
       fillShape(o.elementAt(0), dim + 1, shape);
     }
   }
@@ -157,53 +298,105 @@ class Tensor {
         'DataType error: cannot resolve DataType of ${o.runtimeType}');
   }
 
+  /// Copies [src] into the tensor.
+  ///
+  /// [ByteBuffer] inputs and typed lists whose element type matches the
+  /// tensor type (see [ByteConversionUtils.matchesTensorType]) are copied
+  /// straight into tensor memory with a single memcpy. Other typed lists,
+  /// such as a [Float64List] for a float32 tensor, are converted element by
+  /// element. Nested lists of supported types are walked once and written
+  /// directly into tensor memory; everything else goes through
+  /// [ByteConversionUtils.convertObjectToBytes] first.
   void setTo(Object src) {
-    Uint8List bytes = _convertObjectToBytes(src);
-    int size = bytes.length;
-    final ptr = calloc<Uint8>(size);
-    checkState(isNotNull(ptr), message: 'unallocated');
-    final externalTypedData = ptr.asTypedList(size);
-    externalTypedData.setRange(0, bytes.length, bytes);
-    try {
-      checkState(tfliteBinding.TfLiteTensorCopyFromBuffer(
-              _tensor, ptr.cast(), bytes.length) ==
-          TfLiteStatus.kTfLiteOk);
-    } catch (_) {
-      rethrow;
-    } finally {
-      calloc.free(ptr);
+    if (src is ByteBuffer) {
+      src = src.asUint8List();
+    }
+    if (src is TypedData && ByteConversionUtils.matchesTensorType(src, type)) {
+      _copyFromTypedData(src);
+      return;
+    }
+    if (src is List && ByteConversionUtils.supportsFlatten(type)) {
+      ByteConversionUtils.flattenInto(src, typedData, type);
+      return;
+    }
+    _copyFromTypedData(_convertObjectToBytes(src));
+  }
+
+  /// Checks that [buffer] can be copied to or from this tensor as-is.
+  ///
+  /// Throws [ArgumentError] if the element type of [buffer] does not match
+  /// the tensor type (see [ByteConversionUtils.matchesTensorType]) or if its
+  /// byte length differs from [numBytes].
+  void checkBuffer(TypedData buffer) => _checkBuffer(buffer, type, _size);
+
+  static void _checkBuffer(TypedData buffer, TensorType type, int size) {
+    if (!ByteConversionUtils.matchesTensorType(buffer, type)) {
+      throw ArgumentError(
+          'Buffer of type ${buffer.runtimeType} does not match tensor type $type');
     }
+    checkArgument(buffer.lengthInBytes == size,
+        message:
+            'Buffer of ${buffer.lengthInBytes} bytes does not match tensor size of $size bytes');
+  }
+
+  void _copyFromTypedData(TypedData src) {
+    checkBuffer(src);
+    final size = _size;
+    final ptr = cast<Uint8>(_data);
+    checkState(isNotNull(ptr), message: 'Tensor data is null.');
+    ptr
+        .asTypedList(size)
+        .setRange(0, size, src.buffer.asUint8List(src.offsetInBytes, size));
   }
 
+  /// Copies the tensor data into [dst] and returns the copied object.
+  ///
+  /// [ByteBuffer], contiguous [TensorView] and typed list destinations whose
+  /// element type matches the tensor type are filled in place with a single
+  /// memcpy from tensor memory. Nested lists and other typed lists, such as
+  /// a [Float64List] for a float32 tensor, are filled element by element
+  /// from a decoded copy of the data.
   Object copyTo(Object dst) {
-    int size = tfliteBinding.TfLiteTensorByteSize(_tensor);
-    final ptr = calloc<Uint8>(size);
-    checkState(isNotNull(ptr), message: 'unallocated');
-    final externalTypedData = ptr.asTypedList(size);
-    checkState(
-        tfliteBinding.TfLiteTensorCopyToBuffer(_tensor, ptr.cast(), size) ==
-            TfLiteStatus.kTfLiteOk);
-    // Clone the data, because once `free(ptr)`, `externalTypedData` will be
-    // volatile
-    final bytes = externalTypedData.sublist(0);
-    data = bytes;
-    late Object obj;
-    if (dst is Uint8List) {
-      obj = bytes;
-    } else if (dst is ByteBuffer) {
-      ByteData bdata = dst.asByteData();
-      for (int i = 0; i < bdata.lengthInBytes; i++) {
-        bdata.setUint8(i, bytes[i]);
-      }
-      obj = bdata.buffer;
-    } else {
-      obj = _convertBytesToObject(bytes);
+    final ptr = cast<Uint8>(_data);
+    checkState(isNotNull(ptr), message: 'Tensor data is null.');
+    return copyBytesTo(ptr.asTypedList(_size), type, shape, dst);
+  }
+
+  /// Copies raw tensor data [src] of the given [type] and [shape] into [dst]
+  /// like [copyTo] does, for data copied out of a tensor elsewhere, such as
+  /// in another isolate.
+  static Object copyBytesTo(
+      Uint8List src, TensorType type, List<int> shape, Object dst) {
+    final size = src.length;
+    if (dst is ByteBuffer) {
+      final bytes = dst.asUint8List();
+      _checkBuffer(bytes, type, size);
+      bytes.setRange(0, size, src);
+      return dst;
+    }
+    if (dst is TensorView) {
+      checkArgument(dst.type == type,
+          message:
+              'Output view of type ${dst.type} does not match tensor type $type');
+      checkArgument(dst.isContiguous, message: 'Output view must be contiguous');
+      final target = dst.data;
+      final elementSize = target.elementSizeInBytes;
+      checkArgument(dst.length * elementSize == size,
+          message:
+              'Output view of ${dst.length * elementSize} bytes does not match tensor size of $size bytes');
+      target.buffer
+          .asUint8List(target.offsetInBytes + dst.offset * elementSize, size)
+          .setRange(0, size, src);
+      return dst;
+    }
+    if (dst is TypedData && ByteConversionUtils.matchesTensorType(dst, type)) {
+      _checkBuffer(dst, type, size);
+      dst.buffer.asUint8List(dst.offsetInBytes, size).setRange(0, size, src);
+      return dst;
     }
-    calloc.free(ptr);
+    final obj = ByteConversionUtils.convertBytesToObject(src, type, shape);
     if (obj is List && dst is List) {
       _duplicateList(obj, dst);
-    } else {
-      dst = obj;
     }
     return obj;
   }
@@ -212,11 +405,7 @@ class Tensor {
     return ByteConversionUtils.convertObjectToBytes(o, type);
   }
 
-  Object _convertBytesToObject(Uint8List bytes) {
-    return ByteConversionUtils.convertBytesToObject(bytes, type, shape);
-  }
-
-  void _duplicateList(List obj, List dst) {
+  static void _duplicateList(List obj, List dst) {
     var objShape = obj.shape;
     var dstShape = dst.shape;
     var equal = true;
@@ -243,7 +432,7 @@ class Tensor {
     if (input == null) {
       return null;
     }
-    if (input is ByteBuffer || input is Uint8List) {
+    if (input is ByteBuffer || input is TypedData) {
       return null;
     }
 
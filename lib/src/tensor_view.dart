@@ -0,0 +1,340 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:typed_data';
+
+import 'tensor.dart';
+
+/// Strided n-dimensional view over typed tensor data.
+///
+/// A [TensorView] is a window onto a flat typed buffer: either native tensor
+/// memory (see [Tensor.view]) or a Dart typed list. [slice], [select] and
+/// [transpose] only rewrite shape, strides and offset, so they never copy
+/// elements.
+///
+/// Float16 data is exposed as its raw 16-bit pattern.
+class TensorView {
+  TensorView._(this._data, this.type, this.shape, this.strides, this.offset)
+      : _isFloat = _data is Float32List || _data is Float64List;
+
+  /// Creates a contiguous row-major view of [data] with the given [shape].
+  ///
+  /// [type] defaults to the type implied by the typed list of [data].
+  ///
+  /// Throws [ArgumentError] if [shape] does not cover [data] exactly.
+  factory TensorView(TypedData data, List<int> shape, {TensorType? type}) {
+    final list = _asNumList(data);
+    final numElements = _numElements(shape);
+    if (numElements != list.length) {
+      throw ArgumentError(
+          'Total elements mismatch expected: $numElements elements for shape: $shape but found ${list.length}');
+    }
+    return TensorView._(
+      list,
+      type ?? _typeOf(data),
+      List.unmodifiable(shape),
+      List.unmodifiable(_contiguousStrides(shape)),
+      0,
+    );
+  }
+
+  final List<num> _data;
+  final bool _isFloat;
+
+  /// Element type of the viewed data.
+  final TensorType type;
+
+  /// Size of each dimension.
+  final List<int> shape;
+
+  /// Distance, in elements, between consecutive indexes of each dimension.
+  final List<int> strides;
+
+  /// Index in [data] of the element at index (0, ..., 0).
+  final int offset;
+
+  /// Backing typed buffer shared by every view derived from this one.
+  TypedData get data => _data as TypedData;
+
+  /// Number of dimensions.
+  int get rank => shape.length;
+
+  /// Total number of elements in the view.
+  int get length => _numElements(shape);
+
+  /// Whether the elements are laid out row-major without gaps.
+  bool get isContiguous {
+    var expected = 1;
+    for (var i = shape.length - 1; i >= 0; i--) {
+      if (shape[i] != 1 && strides[i] != expected) {
+        return false;
+      }
+      expected *= shape[i];
+    }
+    return true;
+  }
+
+  /// Returns the element at [index], which must have [rank] entries.
+  num get(List<int> index) => _data[_offsetOf(index)];
+
+  /// Returns the element at the given position without allocating an index
+  /// list. Only the first [rank] arguments are used.
+  num at(int i0, [int i1 = 0, int i2 = 0, int i3 = 0, int i4 = 0]) {
+    var o = offset;
+    final r = shape.length;
+    if (r > 0) o += _checkedIndex(0, i0) * strides[0];
+    if (r > 1) o += _checkedIndex(1, i1) * strides[1];
+    if (r > 2) o += _checkedIndex(2, i2) * strides[2];
+    if (r > 3) o += _checkedIndex(3, i3) * strides[3];
+    if (r > 4) o += _checkedIndex(4, i4) * strides[4];
+    if (r > 5) {
+      throw UnsupportedError('at() supports up to 5 dimensions, use get()');
+    }
+    return _data[o];
+  }
+
+  /// Stores [value] at [index], converting it to the element type.
+  void set(List<int> index, num value) {
+    _data[_offsetOf(index)] = _isFloat ? value.toDouble() : value.toInt();
+  }
+
+  /// Returns a view restricted to `[start, end)` along [axis].
+  TensorView slice(int axis, int start, [int? end]) {
+    RangeError.checkValidIndex(axis, shape, 'axis', shape.length);
+    final stop = RangeError.checkValidRange(start, end, shape[axis]);
+    final newShape = List<int>.of(shape);
+    newShape[axis] = stop - start;
+    return TensorView._(_data, type, List.unmodifiable(newShape), strides,
+        offset + start * strides[axis]);
+  }
+
+  /// Returns the view at [index] along [axis], with that axis removed.
+  TensorView select(int axis, int index) {
+    RangeError.checkValidIndex(axis, shape, 'axis', shape.length);
+    RangeError.checkValidIndex(index, null, 'index', shape[axis]);
+    final newShape = List<int>.of(shape)..removeAt(axis);
+    final newStrides = List<int>.of(strides)..removeAt(axis);
+    return TensorView._(_data, type, List.unmodifiable(newShape),
+        List.unmodifiable(newStrides), offset + index * strides[axis]);
+  }
+
+  /// Returns a view with dimensions permuted by [axes], or reversed when
+  /// [axes] is omitted.
+  TensorView transpose([List<int>? axes]) {
+    final order = axes ?? List.generate(rank, (i) => rank - 1 - i);
+    if (order.length != rank || order.toSet().length != rank) {
+      throw ArgumentError('Invalid permutation $order for rank $rank');
+    }
+    for (final axis in order) {
+      RangeError.checkValidIndex(axis, shape, 'axes', rank);
+    }
+    return TensorView._(
+      _data,
+      type,
+      List.unmodifiable([for (final a in order) shape[a]]),
+      List.unmodifiable([for (final a in order) strides[a]]),
+      offset,
+    );
+  }
+
+  /// Returns a view of the same elements with a new [newShape].
+  ///
+  /// Only contiguous views can be reshaped without copying; call [copy]
+  /// first otherwise.
+  TensorView reshape(List<int> newShape) {
+    if (!isContiguous) {
+      throw StateError('Cannot reshape a non-contiguous view, copy it first');
+    }
+    if (_numElements(newShape) != length) {
+      throw ArgumentError(
+          'Total elements mismatch expected: $length elements for shape: $newShape');
+    }
+    return TensorView._(_data, type, List.unmodifiable(newShape),
+        List.unmodifiable(_contiguousStrides(newShape)), offset);
+  }
+
+  /// Returns a contiguous copy of this view backed by a new typed buffer.
+  TensorView copy() {
+    final out = _newLike(length);
+    _copyInto(out);
+    return TensorView._(out, type, shape,
+        List.unmodifiable(_contiguousStrides(shape)), 0);
+  }
+
+  /// Copies the elements, in row-major order, into [target].
+  ///
+  /// [target] must hold exactly [length] elements. Elements are converted
+  /// to the element type of [target]; a typed list with the same element
+  /// type as the view is copied with a single memcpy. Floating-point views
+  /// can only be copied into floating-point targets.
+  void copyInto(List<num> target) {
+    if (target.length != length) {
+      throw ArgumentError(
+          'Target holds ${target.length} elements while the view has $length');
+    }
+    _copyInto(target);
+  }
+
+  /// Materializes the view as nested Dart lists.
+  List toList() {
+    if (rank == 0) {
+      return [_data[offset]];
+    }
+    return _toList(0, offset);
+  }
+
+  int _checkedIndex(int axis, int index) {
+    if (index < 0 || index >= shape[axis]) {
+      throw RangeError.range(index, 0, shape[axis] - 1, 'index[$axis]');
+    }
+    return index;
+  }
+
+  int _offsetOf(List<int> index) {
+    if (index.length != shape.length) {
+      throw ArgumentError(
+          'Index $index does not match view of rank ${shape.length}');
+    }
+    var o = offset;
+    for (var i = 0; i < index.length; i++) {
+      o += _checkedIndex(i, index[i]) * strides[i];
+    }
+    return o;
+  }
+
+  void _copyInto(List<num> target) {
+    if (length == 0) {
+      return;
+    }
+    final toDouble = target is List<double>;
+    if (_isFloat && !toDouble) {
+      throw ArgumentError(
+          'Cannot copy $type elements into ${target.runtimeType}');
+    }
+    if (isContiguous &&
+        target is TypedData &&
+        _sameElementType(_data as TypedData, target as TypedData)) {
+      final src = _data as TypedData;
+      final elementSize = src.elementSizeInBytes;
+      final dst = target as TypedData;
+      dst.buffer.asUint8List(dst.offsetInBytes, length * elementSize).setRange(
+          0,
+          length * elementSize,
+          src.buffer.asUint8List(
+              src.offsetInBytes + offset * elementSize, length * elementSize));
+      return;
+    }
+    final r = rank;
+    final index = List<int>.filled(r, 0);
+    var o = offset;
+    for (var n = 0; n < target.length; n++) {
+      target[n] = toDouble ? _data[o].toDouble() : _data[o];
+      for (var d = r - 1; d >= 0; d--) {
+        index[d]++;
+        o += strides[d];
+        if (index[d] < shape[d]) {
+          break;
+        }
+        o -= strides[d] * shape[d];
+        index[d] = 0;
+      }
+    }
+  }
+
+  List _toList(int dim, int base) {
+    if (dim == rank - 1) {
+      return List.generate(shape[dim], (i) => _data[base + i * strides[dim]]);
+    }
+    return List.generate(
+        shape[dim], (i) => _toList(dim + 1, base + i * strides[dim]));
+  }
+
+  List<num> _newLike(int length) {
+    final src = _data;
+    if (src is Float32List) return Float32List(length);
+    if (src is Float64List) return Float64List(length);
+    if (src is Int64List) return Int64List(length);
+    if (src is Uint64List) return Uint64List(length);
+    if (src is Int32List) return Int32List(length);
+    if (src is Uint32List) return Uint32List(length);
+    if (src is Int16List) return Int16List(length);
+    if (src is Uint16List) return Uint16List(length);
+    if (src is Int8List) return Int8List(length);
+    return Uint8List(length);
+  }
+
+  static bool _sameElementType(TypedData a, TypedData b) {
+    return a.runtimeType == b.runtimeType ||
+        (a.elementSizeInBytes == b.elementSizeInBytes &&
+            _kindOf(a) == _kindOf(b));
+  }
+
+  // 0 for floating point, 1 for signed and 2 for unsigned integers.
+  static int _kindOf(TypedData data) {
+    if (data is Float32List || data is Float64List) return 0;
+    if (data is Int64List ||
+        data is Int32List ||
+        data is Int16List ||
+        data is Int8List) {
+      return 1;
+    }
+    return 2;
+  }
+
+  static List<num> _asNumList(TypedData data) {
+    if (data is List<num>) {
+      return data as List<num>;
+    }
+    if (data is ByteData) {
+      return data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+    }
+    throw ArgumentError('Unsupported buffer type ${data.runtimeType}');
+  }
+
+  static TensorType _typeOf(TypedData data) {
+    if (data is Float32List) return TensorType.float32;
+    if (data is Float64List) return TensorType.float64;
+    if (data is Int64List) return TensorType.int64;
+    if (data is Uint64List) return TensorType.uint64;
+    if (data is Int32List) return TensorType.int32;
+    if (data is Uint32List) return TensorType.uint32;
+    if (data is Int16List) return TensorType.int16;
+    if (data is Uint16List) return TensorType.uint16;
+    if (data is Int8List) return TensorType.int8;
+    return TensorType.uint8;
+  }
+
+  static int _numElements(List<int> shape) {
+    var n = 1;
+    for (var i = 0; i < shape.length; i++) {
+      n *= shape[i];
+    }
+    return n;
+  }
+
+  static List<int> _contiguousStrides(List<int> shape) {
+    final strides = List<int>.filled(shape.length, 1);
+    for (var i = shape.length - 2; i >= 0; i--) {
+      strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    return strides;
+  }
+
+  @override
+  String toString() {
+    return 'TensorView{type: $type, shape: $shape, strides: $strides, offset: $offset}';
+  }
+}
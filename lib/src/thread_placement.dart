@@ -0,0 +1,273 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:ffi';
+import 'dart:io';
+
+import 'package:ffi/ffi.dart';
+import 'package:quiver/check.dart';
+import 'package:flutter_litert/src/bindings/runtime_bindings.dart';
+
+/// Linux scheduling policy of a thread.
+enum SchedulingPolicy {
+  /// `SCHED_OTHER`, the default time-sharing policy.
+  normal,
+
+  /// `SCHED_BATCH`: CPU-bound work that gives way to interactive threads.
+  batch,
+
+  /// `SCHED_IDLE`: runs only when nothing else wants the CPU.
+  idle,
+}
+
+/// CPU affinity, niceness and scheduling policy of a thread.
+///
+/// Fields left null are not changed when the placement is applied. Only
+/// implemented on Linux and Android (see [isSupported]); elsewhere
+/// placements are ignored.
+class ThreadPlacement {
+  ThreadPlacement({Iterable<int>? cpus, this.nice, this.policy})
+      : cpus = cpus == null ? null : Set.unmodifiable(cpus) {
+    final chosen = this.cpus;
+    if (chosen != null) {
+      checkArgument(chosen.isNotEmpty, message: 'cpus must not be empty');
+      for (final cpu in chosen) {
+        RangeError.checkValueInInterval(
+            cpu, 0, tfliteFlutterMaxCpus - 1, 'cpus');
+      }
+    }
+  }
+
+  /// CPUs the thread may run on, e.g. the big cores of a big.LITTLE SoC.
+  final Set<int>? cpus;
+
+  /// Niceness between -20 (favoured) and 19 (yields to everything). Raising
+  /// priority again usually needs `CAP_SYS_NICE` or `RLIMIT_NICE`.
+  final int? nice;
+
+  /// Scheduling policy.
+  final SchedulingPolicy? policy;
+
+  /// Whether thread placement is available on this platform.
+  static bool get isSupported =>
+      (Platform.isLinux || Platform.isAndroid) && runtimeBinding != null;
+
+  /// Kernel id of the calling thread, or 0 if unsupported.
+  static int get currentThreadId => runtimeBinding?.currentThreadId() ?? 0;
+
+  /// Kernel ids of every thread of this process, or none if unsupported.
+  static List<int> threadIds() {
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      return const <int>[];
+    }
+    var capacity = 64;
+    for (;;) {
+      final ids = calloc<Int64>(capacity);
+      try {
+        final count = runtime.listThreads(ids, capacity);
+        if (count < 0) {
+          return const <int>[];
+        }
+        if (count <= capacity) {
+          return List<int>.of(ids.asTypedList(count));
+        }
+        capacity = count + 16;
+      } finally {
+        calloc.free(ids);
+      }
+    }
+  }
+
+  /// Reads the current placement of thread [threadId], or null if it has
+  /// exited or placement is unsupported.
+  static ThreadPlacement? ofThread(int threadId) {
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      return null;
+    }
+    final native = calloc<TfLiteFlutterPlacement>();
+    try {
+      if (runtime.getThreadPlacement(threadId, native) != 0) {
+        return null;
+      }
+      return _fromNative(native.ref);
+    } finally {
+      calloc.free(native);
+    }
+  }
+
+  /// Applies this placement to thread [threadId] (0 for the calling
+  /// thread). Returns 0, the errno of the first setting that failed, or -1
+  /// if unsupported.
+  int applyTo(int threadId) {
+    final runtime = runtimeBinding;
+    if (runtime == null) {
+      return -1;
+    }
+    final native = calloc<TfLiteFlutterPlacement>();
+    try {
+      writeTo(native.ref);
+      return runtime.setThreadPlacement(threadId, native);
+    } finally {
+      calloc.free(native);
+    }
+  }
+
+  /// Fills the native mirror of this placement.
+  void writeTo(TfLiteFlutterPlacement native) {
+    native.flags = (cpus != null ? tfliteFlutterPlaceCpus : 0) |
+        (nice != null ? tfliteFlutterPlaceNice : 0) |
+        (policy != null ? tfliteFlutterPlacePolicy : 0);
+    native.nice = nice ?? 0;
+    native.policy = policy?.index ?? 0;
+    for (var word = 0; word < tfliteFlutterMaxCpus ~/ 64; word++) {
+      native.cpus[word] = 0;
+    }
+    for (final cpu in cpus ?? const <int>{}) {
+      native.cpus[cpu ~/ 64] |= 1 << (cpu % 64);
+    }
+  }
+
+  static ThreadPlacement _fromNative(TfLiteFlutterPlacement native) {
+    final cpus = <int>[];
+    for (var word = 0; word < tfliteFlutterMaxCpus ~/ 64; word++) {
+      final bits = native.cpus[word];
+      for (var bit = 0; bits != 0 && bit < 64; bit++) {
+        if (bits & (1 << bit) != 0) {
+          cpus.add(word * 64 + bit);
+        }
+      }
+    }
+    return ThreadPlacement(
+        cpus: cpus.isEmpty ? null : cpus,
+        nice: native.nice,
+        policy: SchedulingPolicy.values[native.policy]);
+  }
+
+  @override
+  String toString() {
+    return 'ThreadPlacement{cpus: ${cpus?.toList()}, nice: $nice, policy: ${policy?.name}}';
+  }
+}
+
+/// A thread placed for an interpreter and the placement it actually has.
+class PlacedThread {
+  PlacedThread(this.threadId, this.status, this.achieved);
+
+  /// Kernel thread id.
+  final int threadId;
+
+  /// Result of applying the requested placement: 0, or the errno of the
+  /// first setting the kernel refused.
+  final int status;
+
+  /// Placement read back from the kernel, or null if the thread exited.
+  final ThreadPlacement? achieved;
+
+  @override
+  String toString() =>
+      'PlacedThread{$threadId, status: $status, achieved: $achieved}';
+}
+
+/// Applies one [ThreadPlacement] to the threads an interpreter runs on.
+///
+/// Created by [InterpreterOptions.placement]. Only threads started by the
+/// native calls that create thread pools are placed: [placeThreadsStartedBy]
+/// lists the threads of the process right before such a call, such as
+/// creating a delegate or interpreter, allocating tensors or the first
+/// invocation, and places those that appear while it runs. Threads of the
+/// Dart VM, the engine and other isolates are left alone, unless one
+/// happens to start during that call.
+class ThreadPlacer {
+  ThreadPlacer(this.placement)
+      : _native = runtimeBinding != null
+            ? calloc<TfLiteFlutterPlacement>(2)
+            : nullptr {
+    if (_native != nullptr) {
+      placement.writeTo(_native.ref);
+      _finalizer.attach(this, _native.cast());
+    }
+  }
+
+  // Interpreters keep the placer after their options are deleted, so the
+  // native copy lives as long as the placer.
+  static final NativeFinalizer _finalizer = NativeFinalizer(calloc.nativeFree);
+
+  final ThreadPlacement placement;
+  final Map<int, int> _delegateThreads = <int, int>{};
+
+  // The placement, followed by room to save the caller's affinity.
+  final Pointer<TfLiteFlutterPlacement> _native;
+
+  /// Native copy of [placement], or null pointer if unsupported.
+  Pointer<TfLiteFlutterPlacement> get base => _native;
+
+  /// Threads started by delegates created with [startDelegate], with the
+  /// status of each.
+  Map<int, int> get delegateThreads => Map.unmodifiable(_delegateThreads);
+
+  /// Runs [start], a native call that may start threads, and places the
+  /// threads that appeared while it ran. Their ids are added to [placed]
+  /// with the status of each.
+  T placeThreadsStartedBy<T>(T Function() start, Map<int, int> placed) {
+    return placeStartedBy(_native, start, placed);
+  }
+
+  /// Creates a delegate with [create], placing the thread pool it starts.
+  T startDelegate<T>(T Function() create) {
+    return placeThreadsStartedBy(create, _delegateThreads);
+  }
+
+  /// [placeThreadsStartedBy] for the native copy of a placement, e.g. the
+  /// [base] of a placer owned by another isolate.
+  static T placeStartedBy<T>(Pointer<TfLiteFlutterPlacement> placement,
+      T Function() start, Map<int, int> placed) {
+    if (placement == nullptr || !ThreadPlacement.isSupported) {
+      return start();
+    }
+    final before = ThreadPlacement.threadIds().toSet();
+    final result = start();
+    for (final id in ThreadPlacement.threadIds()) {
+      if (!before.contains(id)) {
+        placed[id] = runtimeBinding!.setThreadPlacement(id, placement);
+      }
+    }
+    return result;
+  }
+
+  /// Runs [body] with the calling thread restricted to [placement]'s CPUs.
+  ///
+  /// Niceness and policy are not applied to the calling thread, which is
+  /// shared with the rest of the isolate and could not lower them again.
+  T run<T>(T Function() body) {
+    if (placement.cpus == null ||
+        _native == nullptr ||
+        !ThreadPlacement.isSupported) {
+      return body();
+    }
+    final runtime = runtimeBinding!;
+    final saved = _native + 1;
+    final swapped = runtime.swapThreadAffinity(_native, saved) == 0;
+    try {
+      return body();
+    } finally {
+      if (swapped) {
+        runtime.setThreadPlacement(0, saved);
+      }
+    }
+  }
+}
@@ -20,6 +20,8 @@ import 'dart:typed_data';
 
 import 'package:flutter_litert/flutter_litert.dart';
 
+import 'nested_list_view.dart';
+
 class ByteConversionError extends ArgumentError {
   ByteConversionError({
     required this.input,
@@ -40,6 +42,14 @@ class ByteConversionUtils {
     if (o is ByteBuffer) {
       return o.asUint8List();
     }
+    if (o is TypedData && matchesTensorType(o, tensorType)) {
+      return o.buffer.asUint8List(o.offsetInBytes, o.lengthInBytes);
+    }
+    if (o is List && supportsFlatten(tensorType)) {
+      final flat = _newTypedList(tensorType, _countElements(o))!;
+      flattenInto(o, flat, tensorType);
+      return flat.buffer.asUint8List();
+    }
     List<int> bytes = <int>[];
     if (o is List) {
       for (var e in o) {
@@ -51,6 +61,178 @@ class ByteConversionUtils {
     return Uint8List.fromList(bytes);
   }
 
+  /// Whether the bytes of [data] are already laid out as elements of
+  /// [tensorType], so they can be copied as-is.
+  ///
+  /// Byte containers ([Uint8List], [ByteData]) match every type. Other typed
+  /// lists only match their own element type; [Uint16List] also matches
+  /// float16, whose elements it holds as raw half-precision bits.
+  static bool matchesTensorType(TypedData data, TensorType tensorType) {
+    if (data is Uint8List || data is ByteData) return true;
+    if (data is Float32List) return tensorType == TensorType.float32;
+    if (data is Float64List) return tensorType == TensorType.float64;
+    if (data is Int64List) return tensorType == TensorType.int64;
+    if (data is Uint64List) return tensorType == TensorType.uint64;
+    if (data is Int32List) return tensorType == TensorType.int32;
+    if (data is Uint32List) return tensorType == TensorType.uint32;
+    if (data is Int16List) return tensorType == TensorType.int16;
+    if (data is Uint16List) {
+      return tensorType == TensorType.uint16 ||
+          tensorType == TensorType.float16;
+    }
+    if (data is Int8List) return tensorType == TensorType.int8;
+    return false;
+  }
+
+  /// Whether nested lists for [tensorType] can be written with [flattenInto].
+  static bool supportsFlatten(TensorType tensorType) {
+    switch (tensorType) {
+      case TensorType.float32:
+      case TensorType.int32:
+      case TensorType.int16:
+      case TensorType.int8:
+      case TensorType.uint8:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /// Writes the elements of the nested list [list] into [target] in
+  /// row-major order.
+  ///
+  /// The leaf element type is checked against [tensorType] once and the list
+  /// is walked a single time, writing straight into [target]. [target] must
+  /// be the typed list matching [tensorType] (see [supportsFlatten]) and hold
+  /// exactly as many elements as [list].
+  ///
+  /// Throws [ByteConversionError] if the elements don't match [tensorType] and
+  /// [ArgumentError] if the number of elements doesn't match [target].
+  static void flattenInto(List list, TypedData target, TensorType tensorType) {
+    final length = (target as List).length;
+    final count = _countElements(list);
+    if (count != length) {
+      throw ArgumentError(
+          'Input has $count elements while the target holds $length elements');
+    }
+    final leaf = _firstLeaf(list);
+    if (leaf == null) {
+      return;
+    }
+
+    int written;
+    try {
+      if (tensorType == TensorType.float32) {
+        if (target is! Float32List) {
+          throw ArgumentError(
+              'Cannot flatten float32 data into ${target.runtimeType}');
+        }
+        if (leaf is! num) {
+          throw ByteConversionError(input: leaf, tensorType: tensorType);
+        }
+        written = _fillDouble(list, target, 0);
+      } else {
+        if (!supportsFlatten(tensorType) || target is! List<int>) {
+          throw ArgumentError(
+              'Cannot flatten $tensorType data into ${target.runtimeType}');
+        }
+        if (leaf is! int) {
+          throw ByteConversionError(input: leaf, tensorType: tensorType);
+        }
+        written = _fillInt(list, target as List<int>, 0);
+      }
+    } on RangeError {
+      throw ArgumentError('Input is not a regular (non-ragged) nested list');
+    } on TypeError {
+      throw ArgumentError(
+          'Input contains elements that do not match tensor type $tensorType');
+    }
+    if (written != length) {
+      throw ArgumentError('Input is not a regular (non-ragged) nested list');
+    }
+  }
+
+  static int _fillDouble(List list, Float32List out, int offset) {
+    for (final e in list) {
+      if (e is List) {
+        offset = _fillDouble(e, out, offset);
+      } else {
+        out[offset++] = (e as num).toDouble();
+      }
+    }
+    return offset;
+  }
+
+  static int _fillInt(List list, List<int> out, int offset) {
+    for (final e in list) {
+      if (e is List) {
+        offset = _fillInt(e, out, offset);
+      } else {
+        out[offset++] = e as int;
+      }
+    }
+    return offset;
+  }
+
+  /// Number of elements implied by the first element of every dimension.
+  static int _countElements(List list) {
+    var count = 1;
+    Object? o = list;
+    while (o is List) {
+      count *= o.length;
+      if (o.isEmpty) {
+        break;
+      }
+      o = o[0];
+    }
+    return count;
+  }
+
+  static Object? _firstLeaf(List list) {
+    Object? o = list;
+    while (o is List) {
+      if (o.isEmpty) {
+        return null;
+      }
+      o = o[0];
+    }
+    return o;
+  }
+
+  static TypedData? _newTypedList(TensorType tensorType, int length) {
+    switch (tensorType) {
+      case TensorType.float32:
+        return Float32List(length);
+      case TensorType.int32:
+        return Int32List(length);
+      case TensorType.int16:
+        return Int16List(length);
+      case TensorType.int8:
+        return Int8List(length);
+      case TensorType.uint8:
+        return Uint8List(length);
+      default:
+        return null;
+    }
+  }
+
+  static TypedData? _typedView(TensorType tensorType, ByteBuffer buffer) {
+    switch (tensorType) {
+      case TensorType.float32:
+        return buffer.asFloat32List();
+      case TensorType.int32:
+        return buffer.asInt32List();
+      case TensorType.int16:
+        return buffer.asInt16List();
+      case TensorType.int8:
+        return buffer.asInt8List();
+      case TensorType.uint8:
+        return buffer.asUint8List();
+      default:
+        return null;
+    }
+  }
+
   static Uint8List _convertElementToBytes(Object o, TensorType tensorType) {
     // Float32
     if (tensorType.value == TfLiteType.kTfLiteFloat32) {
@@ -180,42 +362,26 @@ class ByteConversionUtils {
     return decodedStrings;
   }
 
+  /// Decodes [bytes] into a nested list of the given [shape].
+  ///
+  /// Float32, int32, int16, int8 and uint8 data is copied once into a typed
+  /// buffer and returned as a lazy [NestedListView] whose innermost rows are
+  /// typed views of that buffer.
   static Object convertBytesToObject(
       Uint8List bytes, TensorType tensorType, List<int> shape) {
+    if (supportsFlatten(tensorType)) {
+      final copy = Uint8List.fromList(bytes);
+      return NestedListView.of(_typedView(tensorType, copy.buffer)!, shape);
+    }
     // stores flattened data
     List<dynamic> list = [];
-    if (tensorType.value == TfLiteType.kTfLiteInt32) {
-      for (var i = 0; i < bytes.length; i += 4) {
-        list.add(ByteData.view(bytes.buffer).getInt32(i, Endian.little));
-      }
-      return list.reshape<int>(shape);
-    } else if (tensorType.value == TfLiteType.kTfLiteFloat32) {
-      for (var i = 0; i < bytes.length; i += 4) {
-        list.add(ByteData.view(bytes.buffer).getFloat32(i, Endian.little));
-      }
-      return list.reshape<double>(shape);
-    } else if (tensorType.value == TfLiteType.kTfLiteInt16) {
-      for (var i = 0; i < bytes.length; i += 2) {
-        list.add(ByteData.view(bytes.buffer).getInt16(i, Endian.little));
-      }
-      return list.reshape<int>(shape);
-    } else if (tensorType.value == TfLiteType.kTfLiteFloat16) {
+    if (tensorType.value == TfLiteType.kTfLiteFloat16) {
       for (var i = 0; i < bytes.length; i += 2) {
         int float16 = ByteData.view(bytes.buffer).getUint16(i, Endian.little);
         double float32 = _float16ToFloat32(float16);
         list.add(float32);
       }
       return list.reshape<double>(shape);
-    } else if (tensorType.value == TfLiteType.kTfLiteInt8) {
-      for (var i = 0; i < bytes.length; i += 1) {
-        list.add(ByteData.view(bytes.buffer).getInt8(i));
-      }
-      return list.reshape<int>(shape);
-    } else if (tensorType.value == TfLiteType.kTfLiteUInt8) {
-      for (var i = 0; i < bytes.length; i += 1) {
-        list.add(ByteData.view(bytes.buffer).getUint8(i));
-      }
-      return list.reshape<int>(shape);
     } else if (tensorType.value == TfLiteType.kTfLiteInt64) {
       for (var i = 0; i < bytes.length; i += 8) {
         list.add(ByteData.view(bytes.buffer).getInt64(i));
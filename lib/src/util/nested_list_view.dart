@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:collection';
+import 'dart:typed_data';
+
+import 'list_shape_extension.dart';
+
+/// Fixed-length nested list whose rows are created on access.
+///
+/// Used to expose a flat typed buffer as `List<List<...>>` without building
+/// one Dart list per row up front. Innermost rows are zero-copy views of the
+/// buffer, so element writes go straight to the backing storage.
+class NestedListView<E> extends ListBase<E> {
+  NestedListView(this._length, this._rowAt);
+
+  final int _length;
+  final E Function(int index) _rowAt;
+
+  @override
+  int get length => _length;
+
+  @override
+  set length(int newLength) {
+    throw UnsupportedError('Cannot change the length of a nested list view');
+  }
+
+  @override
+  E operator [](int index) {
+    RangeError.checkValidIndex(index, this, 'index', _length);
+    return _rowAt(index);
+  }
+
+  @override
+  void operator []=(int index, E value) {
+    throw UnsupportedError('Cannot replace a row of a nested list view');
+  }
+
+  /// Returns a nested view of [flat] with the given row-major [shape].
+  ///
+  /// [flat] must be a [Float32List], [Float64List] or one of the integer
+  /// typed lists. Shapes with more than 5 dimensions fall back to an eager
+  /// [ListShape.reshape].
+  static List of(TypedData flat, List<int> shape) {
+    if (flat is Float32List) {
+      return _nested<double>(
+          flat, shape, (s, e) => Float32List.sublistView(flat, s, e));
+    } else if (flat is Float64List) {
+      return _nested<double>(
+          flat, shape, (s, e) => Float64List.sublistView(flat, s, e));
+    } else if (flat is Int64List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Int64List.sublistView(flat, s, e));
+    } else if (flat is Int32List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Int32List.sublistView(flat, s, e));
+    } else if (flat is Int16List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Int16List.sublistView(flat, s, e));
+    } else if (flat is Int8List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Int8List.sublistView(flat, s, e));
+    } else if (flat is Uint8List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Uint8List.sublistView(flat, s, e));
+    } else if (flat is Uint16List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Uint16List.sublistView(flat, s, e));
+    } else if (flat is Uint32List) {
+      return _nested<int>(
+          flat, shape, (s, e) => Uint32List.sublistView(flat, s, e));
+    }
+    throw ArgumentError('Unsupported buffer type ${flat.runtimeType}');
+  }
+
+  static List _nested<T>(
+      List<T> flat, List<int> shape, List<T> Function(int, int) slice) {
+    final dims = shape.length;
+    var numElements = 1;
+    for (var i = 0; i < dims; i++) {
+      numElements *= shape[i];
+    }
+    if (numElements != flat.length) {
+      throw ArgumentError(
+          'Total elements mismatch expected: $numElements elements for shape: $shape but found ${flat.length}');
+    }
+    if (dims <= 1) {
+      return flat;
+    }
+    if (dims > 5) {
+      return flat.reshape<T>(shape);
+    }
+
+    final strides = List<int>.filled(dims, 1);
+    for (var i = dims - 2; i >= 0; i--) {
+      strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    final rowLength = shape[dims - 1];
+    List<T> row(int start) => slice(start, start + rowLength);
+
+    switch (dims) {
+      case 2:
+        return NestedListView<List<T>>(shape[0], (i) => row(i * strides[0]));
+      case 3:
+        return NestedListView<List<List<T>>>(
+          shape[0],
+          (i) => NestedListView<List<T>>(
+            shape[1],
+            (j) => row(i * strides[0] + j * strides[1]),
+          ),
+        );
+      case 4:
+        return NestedListView<List<List<List<T>>>>(
+          shape[0],
+          (i) => NestedListView<List<List<T>>>(
+            shape[1],
+            (j) => NestedListView<List<T>>(
+              shape[2],
+              (k) => row(i * strides[0] + j * strides[1] + k * strides[2]),
+            ),
+          ),
+        );
+      default:
+        return NestedListView<List<List<List<List<T>>>>>(
+          shape[0],
+          (i) => NestedListView<List<List<List<T>>>>(
+            shape[1],
+            (j) => NestedListView<List<List<T>>>(
+              shape[2],
+              (k) => NestedListView<List<T>>(
+                shape[3],
+                (l) => row(i * strides[0] +
+                    j * strides[1] +
+                    k * strides[2] +
+                    l * strides[3]),
+              ),
+            ),
+          ),
+        );
+    }
+  }
+}
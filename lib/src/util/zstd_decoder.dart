@@ -0,0 +1,913 @@
+/*
+ * Copyright 2025 flutter_litert authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *             http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import 'dart:typed_data';
+
+/// Decoder for zstd-compressed data (RFC 8878), which has no codec in the
+/// Dart SDK.
+///
+/// Frames are decoded block by block and every decoded block is handed to
+/// the caller as soon as it is complete, so besides the input only the
+/// frame's window (at most [maxWindowSize]) is held in memory. Content
+/// checksums are verified when present; frames that need a dictionary are
+/// not supported.
+class ZstdDecoder {
+  ZstdDecoder._(this._input, this._onChunk);
+
+  /// Largest window accepted, zstd's own default decoder limit.
+  static const int maxWindowSize = 1 << 27;
+
+  static const int _maxBlockSize = 1 << 17;
+  static const int _frameMagic = 0xfd2fb528;
+
+  /// Whether [bytes] start with a zstd frame.
+  static bool isZstd(Uint8List bytes) =>
+      bytes.length >= 4 && _readLE(bytes, 0, 4) == _frameMagic;
+
+  /// Decodes every frame of [input], passing the decoded data to [onChunk]
+  /// in order.
+  ///
+  /// Each chunk is a view of the decoder's window and is only valid until
+  /// [onChunk] returns. Throws [FormatException] if [input] is not valid
+  /// zstd data and [UnsupportedError] for dictionaries and windows above
+  /// [maxWindowSize].
+  static void decode(Uint8List input, void Function(Uint8List chunk) onChunk) {
+    ZstdDecoder._(input, onChunk)._decode();
+  }
+
+  final Uint8List _input;
+  final void Function(Uint8List chunk) _onChunk;
+
+  // Decoded data of the current frame; the window precedes [_length].
+  late Uint8List _window;
+  int _length = 0;
+  int _windowSize = 0;
+  int _frameLength = 0;
+  _Xxh64? _checksum;
+
+  final List<int> _repeatOffsets = [1, 4, 8];
+  _HuffmanTable? _huffman;
+  _FseTable? _literalLengths;
+  _FseTable? _offsets;
+  _FseTable? _matchLengths;
+
+  // Decoded literals of the current block, or a view of raw literals.
+  final Uint8List _literalBuffer = Uint8List(_maxBlockSize);
+  Uint8List _literals = Uint8List(0);
+  int _literalStart = 0;
+  int _literalCount = 0;
+
+  void _decode() {
+    final input = _input;
+    if (input.length < 4) {
+      throw const FormatException('Not a zstd stream');
+    }
+    var pos = 0;
+    while (pos < input.length) {
+      _need(pos, 4);
+      final magic = _readLE(input, pos, 4);
+      if (magic & 0xfffffff0 == 0x184d2a50) {
+        // Skippable frame.
+        _need(pos, 8);
+        pos += 8 + _readLE(input, pos + 4, 4);
+        if (pos > input.length) {
+          throw const FormatException('Truncated zstd frame');
+        }
+        continue;
+      }
+      if (magic != _frameMagic) {
+        throw const FormatException('Not a zstd stream');
+      }
+      pos = _decodeFrame(pos + 4);
+    }
+  }
+
+  int _decodeFrame(int pos) {
+    final input = _input;
+    _need(pos, 1);
+    final descriptor = input[pos++];
+    final contentSizeFlag = descriptor >> 6;
+    final singleSegment = descriptor & 0x20 != 0;
+    final hasChecksum = descriptor & 0x04 != 0;
+    if (descriptor & 0x08 != 0) {
+      throw const FormatException('Reserved zstd frame bit set');
+    }
+    var windowSize = 0;
+    if (!singleSegment) {
+      _need(pos, 1);
+      final windowDescriptor = input[pos++];
+      final base = 1 << (10 + (windowDescriptor >> 3));
+      windowSize = base + (base >> 3) * (windowDescriptor & 7);
+    }
+    final dictionaryIdSize = const [0, 1, 2, 4][descriptor & 3];
+    _need(pos, dictionaryIdSize);
+    if (_readLE(input, pos, dictionaryIdSize) != 0) {
+      throw UnsupportedError('zstd dictionaries are not supported');
+    }
+    pos += dictionaryIdSize;
+    final contentSizeSize =
+        contentSizeFlag == 0 ? (singleSegment ? 1 : 0) : 1 << contentSizeFlag;
+    _need(pos, contentSizeSize);
+    var contentSize = -1;
+    if (contentSizeSize > 0) {
+      contentSize = _readLE(input, pos, contentSizeSize);
+      if (contentSizeSize == 2) {
+        contentSize += 256;
+      }
+    }
+    pos += contentSizeSize;
+    if (singleSegment) {
+      windowSize = contentSize;
+    }
+    if (windowSize < 0 || windowSize > maxWindowSize) {
+      throw UnsupportedError('zstd window of $windowSize bytes is too large');
+    }
+
+    final blockLimit = windowSize < _maxBlockSize ? windowSize : _maxBlockSize;
+    _window = Uint8List(windowSize + 2 * _maxBlockSize);
+    _windowSize = windowSize;
+    _length = 0;
+    _frameLength = 0;
+    _checksum = hasChecksum ? _Xxh64() : null;
+    _repeatOffsets
+      ..[0] = 1
+      ..[1] = 4
+      ..[2] = 8;
+    _huffman = null;
+    _literalLengths = null;
+    _offsets = null;
+    _matchLengths = null;
+
+    for (;;) {
+      _need(pos, 3);
+      final header = _readLE(input, pos, 3);
+      pos += 3;
+      final size = header >> 3;
+      if (size > blockLimit) {
+        throw const FormatException('zstd block too large');
+      }
+      _makeRoom();
+      final start = _length;
+      switch ((header >> 1) & 3) {
+        case 0:
+          _need(pos, size);
+          _window.setRange(_length, _length + size, input, pos);
+          _length += size;
+          pos += size;
+          break;
+        case 1:
+          _need(pos, 1);
+          _window.fillRange(_length, _length + size, input[pos]);
+          _length += size;
+          pos += 1;
+          break;
+        case 2:
+          _need(pos, size);
+          _decodeBlock(pos, pos + size, blockLimit);
+          pos += size;
+          break;
+        default:
+          throw const FormatException('Reserved zstd block type');
+      }
+      _emit(start);
+      if (header & 1 != 0) {
+        break;
+      }
+    }
+
+    if (contentSize >= 0 && _frameLength != contentSize) {
+      throw const FormatException('zstd content size mismatch');
+    }
+    final checksum = _checksum;
+    if (checksum != null) {
+      _need(pos, 4);
+      if (checksum.digest() & 0xffffffff != _readLE(input, pos, 4)) {
+        throw const FormatException('zstd checksum mismatch');
+      }
+      pos += 4;
+    }
+    return pos;
+  }
+
+  // Slides the window to the front of the buffer when the next block might
+  // not fit behind it.
+  void _makeRoom() {
+    if (_length + _maxBlockSize <= _window.length) {
+      return;
+    }
+    final keep = _windowSize < _length ? _windowSize : _length;
+    _window.setRange(0, keep, _window, _length - keep);
+    _length = keep;
+  }
+
+  void _emit(int start) {
+    if (_length == start) {
+      return;
+    }
+    _frameLength += _length - start;
+    _checksum?.add(_window, start, _length);
+    _onChunk(Uint8List.sublistView(_window, start, _length));
+  }
+
+  void _decodeBlock(int pos, int end, int blockLimit) {
+    pos = _decodeLiterals(pos, end);
+    final input = _input;
+    _need(pos, 1, end);
+    final first = input[pos++];
+    var count = first;
+    if (first >= 255) {
+      _need(pos, 2, end);
+      count = _readLE(input, pos, 2) + 0x7f00;
+      pos += 2;
+    } else if (first >= 128) {
+      _need(pos, 1, end);
+      count = ((first - 128) << 8) + input[pos++];
+    }
+
+    final window = _window;
+    final blockEnd = _length + blockLimit;
+    var literal = _literalStart;
+    final literalEnd = _literalStart + _literalCount;
+    if (count > 0) {
+      _need(pos, 1, end);
+      final modes = input[pos++];
+      if (modes & 3 != 0) {
+        throw const FormatException('Reserved zstd sequence bits set');
+      }
+      pos = _readTable(modes >> 6, pos, end, _Kind.literalLength);
+      pos = _readTable((modes >> 4) & 3, pos, end, _Kind.offset);
+      pos = _readTable((modes >> 2) & 3, pos, end, _Kind.matchLength);
+      final literalLengths = _literalLengths!;
+      final offsets = _offsets!;
+      final matchLengths = _matchLengths!;
+
+      final stream = _BackwardBits(input, pos, end);
+      var literalState = stream.read(literalLengths.log);
+      var offsetState = stream.read(offsets.log);
+      var matchState = stream.read(matchLengths.log);
+      final repeat = _repeatOffsets;
+      for (var n = 0; n < count; n++) {
+        final offsetCode = offsets.symbols[offsetState];
+        final matchCode = matchLengths.symbols[matchState];
+        final literalCode = literalLengths.symbols[literalState];
+        if (offsetCode > 31 || matchCode > 52 || literalCode > 35) {
+          throw const FormatException('Invalid zstd sequence code');
+        }
+        var offset = (1 << offsetCode) + stream.read(offsetCode);
+        final matchLength =
+            _matchBase[matchCode] + stream.read(_matchBits[matchCode]);
+        final literalLength =
+            _literalBase[literalCode] + stream.read(_literalBits[literalCode]);
+
+        if (offset > 3) {
+          offset -= 3;
+          repeat[2] = repeat[1];
+          repeat[1] = repeat[0];
+          repeat[0] = offset;
+        } else {
+          final index = offset - 1 + (literalLength == 0 ? 1 : 0);
+          if (index == 0) {
+            offset = repeat[0];
+          } else {
+            offset = index < 3 ? repeat[index] : repeat[0] - 1;
+            if (index > 1) {
+              repeat[2] = repeat[1];
+            }
+            repeat[1] = repeat[0];
+            repeat[0] = offset;
+          }
+        }
+
+        if (n != count - 1) {
+          literalState = literalLengths.base[literalState] +
+              stream.read(literalLengths.bits[literalState]);
+          matchState = matchLengths.base[matchState] +
+              stream.read(matchLengths.bits[matchState]);
+          offsetState = offsets.base[offsetState] +
+              stream.read(offsets.bits[offsetState]);
+        }
+
+        if (literal + literalLength > literalEnd) {
+          throw const FormatException('zstd literals overrun');
+        }
+        if (_length + literalLength + matchLength > blockEnd) {
+          throw const FormatException('zstd block too large');
+        }
+        window.setRange(_length, _length + literalLength, _literals, literal);
+        _length += literalLength;
+        literal += literalLength;
+
+        final from = _length - offset;
+        if (offset == 0 || from < 0) {
+          throw const FormatException('zstd offset beyond decoded data');
+        }
+        if (offset >= matchLength) {
+          window.setRange(_length, _length + matchLength, window, from);
+        } else {
+          for (var i = 0; i < matchLength; i++) {
+            window[_length + i] = window[from + i];
+          }
+        }
+        _length += matchLength;
+      }
+      if (stream.remaining != 0) {
+        throw const FormatException('zstd sequences not fully consumed');
+      }
+    }
+    final rest = literalEnd - literal;
+    if (_length + rest > blockEnd) {
+      throw const FormatException('zstd block too large');
+    }
+    window.setRange(_length, _length + rest, _literals, literal);
+    _length += rest;
+  }
+
+  int _readTable(int mode, int pos, int end, _Kind kind) {
+    final _FseTable table;
+    switch (mode) {
+      case 0:
+        table = kind.predefined;
+        break;
+      case 1:
+        _need(pos, 1, end);
+        final symbol = _input[pos++];
+        if (symbol > kind.maxSymbol) {
+          throw const FormatException('Invalid zstd sequence code');
+        }
+        table = _FseTable.rle(symbol);
+        break;
+      case 2:
+        final read = _FseTable.read(_input, pos, end, kind.maxLog);
+        table = read.table;
+        pos = read.end;
+        break;
+      default:
+        final previous = switch (kind) {
+          _Kind.literalLength => _literalLengths,
+          _Kind.offset => _offsets,
+          _Kind.matchLength => _matchLengths,
+        };
+        if (previous == null) {
+          throw const FormatException('Missing zstd sequence table');
+        }
+        table = previous;
+    }
+    switch (kind) {
+      case _Kind.literalLength:
+        _literalLengths = table;
+        break;
+      case _Kind.offset:
+        _offsets = table;
+        break;
+      case _Kind.matchLength:
+        _matchLengths = table;
+        break;
+    }
+    return pos;
+  }
+
+  int _decodeLiterals(int pos, int end) {
+    final input = _input;
+    _need(pos, 1, end);
+    final first = input[pos];
+    final type = first & 3;
+    final format = (first >> 2) & 3;
+    if (type < 2) {
+      int size;
+      if (format & 1 == 0) {
+        size = first >> 3;
+        pos += 1;
+      } else if (format == 1) {
+        _need(pos, 2, end);
+        size = (first >> 4) + (input[pos + 1] << 4);
+        pos += 2;
+      } else {
+        _need(pos, 3, end);
+        size = (first >> 4) + (input[pos + 1] << 4) + (input[pos + 2] << 12);
+        pos += 3;
+      }
+      if (size > _maxBlockSize) {
+        throw const FormatException('zstd literals too large');
+      }
+      if (type == 0) {
+        _need(pos, size, end);
+        _literals = input;
+        _literalStart = pos;
+        _literalCount = size;
+        return pos + size;
+      }
+      _need(pos, 1, end);
+      _literalBuffer.fillRange(0, size, input[pos]);
+      _literals = _literalBuffer;
+      _literalStart = 0;
+      _literalCount = size;
+      return pos + 1;
+    }
+
+    final headerSize = format < 2 ? 3 : format + 2;
+    _need(pos, headerSize, end);
+    final header = _readLE(input, pos, headerSize);
+    final sizeBits = const [10, 10, 14, 18][format];
+    final sizeMask = (1 << sizeBits) - 1;
+    final size = (header >> 4) & sizeMask;
+    final compressedSize = (header >> (4 + sizeBits)) & sizeMask;
+    pos += headerSize;
+    _need(pos, compressedSize, end);
+    if (size > _maxBlockSize) {
+      throw const FormatException('zstd literals too large');
+    }
+    final stop = pos + compressedSize;
+    if (type == 2) {
+      final read = _HuffmanTable.read(input, pos, stop);
+      _huffman = read.table;
+      pos = read.end;
+    }
+    final huffman = _huffman;
+    if (huffman == null) {
+      throw const FormatException('Missing zstd Huffman table');
+    }
+    final out = _literalBuffer;
+    if (format == 0) {
+      huffman.decode(input, pos, stop, out, 0, size);
+    } else {
+      _need(pos, 6, stop);
+      final size1 = _readLE(input, pos, 2);
+      final size2 = _readLE(input, pos + 2, 2);
+      final size3 = _readLE(input, pos + 4, 2);
+      pos += 6;
+      final quarter = (size + 3) >> 2;
+      if (pos + size1 + size2 + size3 > stop || quarter * 3 > size) {
+        throw const FormatException('Invalid zstd jump table');
+      }
+      final end1 = pos + size1;
+      final end2 = end1 + size2;
+      final end3 = end2 + size3;
+      huffman.decode(input, pos, end1, out, 0, quarter);
+      huffman.decode(input, end1, end2, out, quarter, quarter);
+      huffman.decode(input, end2, end3, out, 2 * quarter, quarter);
+      huffman.decode(input, end3, stop, out, 3 * quarter, size - 3 * quarter);
+    }
+    _literals = out;
+    _literalStart = 0;
+    _literalCount = size;
+    return stop;
+  }
+
+  void _need(int pos, int count, [int? end]) {
+    if (pos + count > (end ?? _input.length)) {
+      throw const FormatException('Truncated zstd stream');
+    }
+  }
+
+  static int _readLE(Uint8List bytes, int pos, int count) {
+    var value = 0;
+    for (var i = count - 1; i >= 0; i--) {
+      value = (value << 8) | bytes[pos + i];
+    }
+    return value;
+  }
+
+  static const List<int> _literalBase = [
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 20, 22, //
+    24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384,
+    32768, 65536,
+  ];
+  static const List<int> _literalBits = [
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, //
+    4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+  ];
+  static const List<int> _matchBase = [
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, //
+    23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 37, 39, 41, 43, 47,
+    51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051, 4099, 8195, 16387, 32771,
+    65539,
+  ];
+  static const List<int> _matchBits = [
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, //
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16,
+  ];
+}
+
+/// The three sequence tables, with their limits and predefined tables.
+enum _Kind {
+  literalLength(9, 35),
+  offset(8, 31),
+  matchLength(9, 52);
+
+  const _Kind(this.maxLog, this.maxSymbol);
+
+  final int maxLog;
+  final int maxSymbol;
+
+  _FseTable get predefined => switch (this) {
+        _Kind.literalLength => _FseTable.literalLengths,
+        _Kind.offset => _FseTable.offsets,
+        _Kind.matchLength => _FseTable.matchLengths,
+      };
+}
+
+/// Bits read from the end of a zstd bitstream towards its start. Bits
+/// before the start read as zero.
+class _BackwardBits {
+  _BackwardBits(this._data, this._start, int end) : _end = end {
+    if (end <= _start || _data[end - 1] == 0) {
+      throw const FormatException('Invalid zstd bitstream');
+    }
+    _remaining = (end - _start - 1) * 8 + _data[end - 1].bitLength - 1;
+  }
+
+  final Uint8List _data;
+  final int _start;
+  final int _end;
+  int _remaining = 0;
+
+  /// Unread bits; negative once reads went past the start.
+  int get remaining => _remaining;
+
+  /// Reads the next [count] bits, at most 32.
+  int read(int count) {
+    if (count == 0) {
+      return 0;
+    }
+    _remaining -= count;
+    final pos = _remaining;
+    if (pos >= 0) {
+      return _peek(pos, count);
+    }
+    if (pos + count <= 0) {
+      return 0;
+    }
+    return _peek(0, pos + count) << -pos;
+  }
+
+  int _peek(int pos, int count) {
+    var at = _start + (pos >> 3);
+    final last = at + 5 < _end ? at + 5 : _end;
+    var word = 0;
+    for (var shift = 0; at < last; at++, shift += 8) {
+      word |= _data[at] << shift;
+    }
+    return (word >> (pos & 7)) & ((1 << count) - 1);
+  }
+}
+
+/// Finite State Entropy decoding table.
+class _FseTable {
+  _FseTable(this.log, this.symbols, this.bits, this.base);
+
+  factory _FseTable.rle(int symbol) =>
+      _FseTable(0, Uint8List.fromList([symbol]), Uint8List(1), Uint16List(1));
+
+  factory _FseTable.build(List<int> counts, int log) {
+    final size = 1 << log;
+    final symbols = Uint8List(size);
+    final bits = Uint8List(size);
+    final base = Uint16List(size);
+    final next = List<int>.filled(counts.length, 0);
+    var high = size;
+    for (var s = 0; s < counts.length; s++) {
+      if (counts[s] == -1) {
+        symbols[--high] = s;
+        next[s] = 1;
+      }
+    }
+    final step = (size >> 1) + (size >> 3) + 3;
+    final mask = size - 1;
+    var pos = 0;
+    for (var s = 0; s < counts.length; s++) {
+      final count = counts[s];
+      if (count <= 0) {
+        continue;
+      }
+      next[s] = count;
+      for (var i = 0; i < count; i++) {
+        symbols[pos] = s;
+        do {
+          pos = (pos + step) & mask;
+        } while (pos >= high);
+      }
+    }
+    if (pos != 0) {
+      throw const FormatException('Invalid zstd FSE table');
+    }
+    for (var i = 0; i < size; i++) {
+      final state = next[symbols[i]]++;
+      final n = log - (state.bitLength - 1);
+      bits[i] = n;
+      base[i] = (state << n) - size;
+    }
+    return _FseTable(log, symbols, bits, base);
+  }
+
+  /// Reads a table description starting at [pos].
+  static ({_FseTable table, int end}) read(
+      Uint8List data, int pos, int end, int maxLog) {
+    var bitPos = 0;
+    int bitsAt(int count) {
+      var value = 0;
+      for (var i = 0; i < count; i++) {
+        final p = bitPos + i;
+        final at = pos + (p >> 3);
+        if (at >= end) {
+          throw const FormatException('Truncated zstd FSE table');
+        }
+        value |= ((data[at] >> (p & 7)) & 1) << i;
+      }
+      bitPos += count;
+      return value;
+    }
+
+    final log = bitsAt(4) + 5;
+    if (log > maxLog) {
+      throw const FormatException('zstd FSE accuracy too high');
+    }
+    var remaining = 1 << log;
+    final counts = <int>[];
+    while (remaining > 0) {
+      if (counts.length > 255) {
+        throw const FormatException('Invalid zstd FSE table');
+      }
+      final n = (remaining + 1).bitLength;
+      var value = bitsAt(n);
+      final lower = (1 << (n - 1)) - 1;
+      final threshold = (1 << n) - 1 - (remaining + 1);
+      if (value & lower < threshold) {
+        bitPos--;
+        value &= lower;
+      } else if (value > lower) {
+        value -= threshold;
+      }
+      final count = value - 1;
+      remaining -= count < 0 ? -count : count;
+      counts.add(count);
+      if (count == 0) {
+        for (;;) {
+          final repeat = bitsAt(2);
+          for (var i = 0; i < repeat; i++) {
+            counts.add(0);
+          }
+          if (repeat != 3) {
+            break;
+          }
+        }
+      }
+    }
+    if (remaining != 0 || counts.length > 256) {
+      throw const FormatException('Invalid zstd FSE table');
+    }
+    final table = _FseTable.build(counts, log);
+    return (table: table, end: pos + ((bitPos + 7) >> 3));
+  }
+
+  static final _FseTable literalLengths = _FseTable.build(const [
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, //
+    2, 3, 2, 1, 1, 1, 1, 1, -1, -1, -1, -1,
+  ], 6);
+  static final _FseTable matchLengths = _FseTable.build(const [
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1,
+  ], 6);
+  static final _FseTable offsets = _FseTable.build(const [
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //
+    -1, -1, -1, -1, -1,
+  ], 5);
+
+  final int log;
+  final Uint8List symbols;
+  final Uint8List bits;
+  final Uint16List base;
+}
+
+/// Huffman decoding table for literals.
+class _HuffmanTable {
+  _HuffmanTable(this.log, this.symbols, this.bits);
+
+  /// Reads a tree description starting at [pos].
+  static ({_HuffmanTable table, int end}) read(
+      Uint8List data, int pos, int end) {
+    if (pos >= end) {
+      throw const FormatException('Truncated zstd Huffman tree');
+    }
+    final header = data[pos++];
+    final weights = <int>[];
+    if (header >= 128) {
+      final count = header - 127;
+      final size = (count + 1) >> 1;
+      if (pos + size > end) {
+        throw const FormatException('Truncated zstd Huffman tree');
+      }
+      for (var i = 0; i < count; i++) {
+        final byte = data[pos + (i >> 1)];
+        weights.add(i & 1 == 0 ? byte >> 4 : byte & 15);
+      }
+      pos += size;
+    } else {
+      final stop = pos + header;
+      if (stop > end) {
+        throw const FormatException('Truncated zstd Huffman tree');
+      }
+      final read = _FseTable.read(data, pos, stop, 6);
+      final table = read.table;
+      final stream = _BackwardBits(data, read.end, stop);
+      var state1 = stream.read(table.log);
+      var state2 = stream.read(table.log);
+      for (;;) {
+        if (weights.length > 255) {
+          throw const FormatException('Invalid zstd Huffman tree');
+        }
+        weights.add(table.symbols[state1]);
+        state1 = table.base[state1] + stream.read(table.bits[state1]);
+        if (stream.remaining < 0) {
+          weights.add(table.symbols[state2]);
+          break;
+        }
+        weights.add(table.symbols[state2]);
+        state2 = table.base[state2] + stream.read(table.bits[state2]);
+        if (stream.remaining < 0) {
+          weights.add(table.symbols[state1]);
+          break;
+        }
+      }
+      pos = stop;
+    }
+    return (table: _HuffmanTable.fromWeights(weights), end: pos);
+  }
+
+  factory _HuffmanTable.fromWeights(List<int> weights) {
+    if (weights.length > 255) {
+      throw const FormatException('Invalid zstd Huffman tree');
+    }
+    var total = 0;
+    for (final weight in weights) {
+      if (weight > 11) {
+        throw const FormatException('Invalid zstd Huffman tree');
+      }
+      if (weight > 0) {
+        total += 1 << (weight - 1);
+      }
+    }
+    if (total == 0) {
+      throw const FormatException('Invalid zstd Huffman tree');
+    }
+    final log = total.bitLength;
+    if (log > 11) {
+      throw const FormatException('Invalid zstd Huffman tree');
+    }
+    final rest = (1 << log) - total;
+    if (rest & (rest - 1) != 0) {
+      throw const FormatException('Invalid zstd Huffman tree');
+    }
+    // The last weight is implied by the others.
+    final all = [...weights, rest.bitLength];
+
+    // Longest codes first, each length taking 2^(log - length) slots.
+    final counts = List<int>.filled(log + 2, 0);
+    for (final weight in all) {
+      if (weight > 0) {
+        counts[log + 1 - weight]++;
+      }
+    }
+    final next = List<int>.filled(log + 2, 0);
+    var slot = 0;
+    for (var length = log; length > 0; length--) {
+      next[length] = slot;
+      slot += counts[length] << (log - length);
+    }
+    final symbols = Uint8List(1 << log);
+    final bits = Uint8List(1 << log);
+    for (var s = 0; s < all.length; s++) {
+      final weight = all[s];
+      if (weight == 0) {
+        continue;
+      }
+      final length = log + 1 - weight;
+      final from = next[length];
+      final to = from + (1 << (log - length));
+      symbols.fillRange(from, to, s);
+      bits.fillRange(from, to, length);
+      next[length] = to;
+    }
+    return _HuffmanTable(log, symbols, bits);
+  }
+
+  final int log;
+  final Uint8List symbols;
+  final Uint8List bits;
+
+  /// Decodes [count] literals of the stream `data[start:end]` into [out] at
+  /// [offset].
+  void decode(Uint8List data, int start, int end, Uint8List out, int offset,
+      int count) {
+    final stream = _BackwardBits(data, start, end);
+    final mask = (1 << log) - 1;
+    var state = stream.read(log);
+    for (var i = offset; i < offset + count; i++) {
+      out[i] = symbols[state];
+      final n = bits[state];
+      state = ((state << n) | stream.read(n)) & mask;
+    }
+    // The final state looks ahead [log] bits past the start.
+    if (stream.remaining != -log) {
+      throw const FormatException('Invalid zstd Huffman stream');
+    }
+  }
+}
+
+/// Streaming XXH64 with seed 0, as used by zstd content checksums.
+class _Xxh64 {
+  static const int _p1 = 0x9e3779b185ebca87;
+  static const int _p2 = 0xc2b2ae3d27d4eb4f;
+  static const int _p3 = 0x165667b19e3779f9;
+  static const int _p4 = 0x85ebca77c2b2ae63;
+  static const int _p5 = 0x27d4eb2f165667c5;
+
+  int _v1 = _p1 + _p2;
+  int _v2 = _p2;
+  int _v3 = 0;
+  int _v4 = -_p1;
+  final Uint8List _buffer = Uint8List(32);
+  late final ByteData _bufferData = ByteData.sublistView(_buffer);
+  int _buffered = 0;
+  int _total = 0;
+
+  static int _rotl(int x, int r) => (x << r) | (x >>> (64 - r));
+
+  static int _round(int acc, int lane) => _rotl(acc + lane * _p2, 31) * _p1;
+
+  void _stripe(ByteData data, int at) {
+    _v1 = _round(_v1, data.getUint64(at, Endian.little));
+    _v2 = _round(_v2, data.getUint64(at + 8, Endian.little));
+    _v3 = _round(_v3, data.getUint64(at + 16, Endian.little));
+    _v4 = _round(_v4, data.getUint64(at + 24, Endian.little));
+  }
+
+  void add(Uint8List data, int start, int end) {
+    _total += end - start;
+    var i = start;
+    if (_buffered > 0) {
+      final take = 32 - _buffered < end - i ? 32 - _buffered : end - i;
+      _buffer.setRange(_buffered, _buffered + take, data, i);
+      _buffered += take;
+      i += take;
+      if (_buffered < 32) {
+        return;
+      }
+      _stripe(_bufferData, 0);
+      _buffered = 0;
+    }
+    final view = ByteData.sublistView(data);
+    for (; i + 32 <= end; i += 32) {
+      _stripe(view, i);
+    }
+    _buffer.setRange(0, end - i, data, i);
+    _buffered = end - i;
+  }
+
+  int digest() {
+    int h;
+    if (_total >= 32) {
+      h = _rotl(_v1, 1) + _rotl(_v2, 7) + _rotl(_v3, 12) + _rotl(_v4, 18);
+      for (final v in [_v1, _v2, _v3, _v4]) {
+        h = (h ^ _round(0, v)) * _p1 + _p4;
+      }
+    } else {
+      h = _p5;
+    }
+    h += _total;
+    var i = 0;
+    for (; i + 8 <= _buffered; i += 8) {
+      h ^= _round(0, _bufferData.getUint64(i, Endian.little));
+      h = _rotl(h, 27) * _p1 + _p4;
+    }
+    if (i + 4 <= _buffered) {
+      h ^= _bufferData.getUint32(i, Endian.little) * _p1;
+      h = _rotl(h, 23) * _p2 + _p3;
+      i += 4;
+    }
+    for (; i < _buffered; i++) {
+      h ^= _buffer[i] * _p5;
+      h = _rotl(h, 11) * _p1;
+    }
+    h ^= h >>> 33;
+    h *= _p2;
+    h ^= h >>> 29;
+    h *= _p3;
+    h ^= h >>> 32;
+    return h;
+  }
+}
@@ -0,0 +1,671 @@
+// Copyright 2025 flutter_litert authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// For sched_setaffinity, CPU_SET and SCHED_IDLE.
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "tflite_flutter_runtime.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+static TfLiteFlutterApi g_api;
+static int g_api_set = 0;
+
+void TfLiteFlutter_SetApi(const TfLiteFlutterApi* api) {
+    if (!api) {
+        g_api_set = 0;
+        return;
+    }
+    g_api = *api;
+    g_api_set = 1;
+}
+
+static void FillTensorInfo(const TfLiteTensor* tensor, TfLiteFlutterTensorInfo* info) {
+    memset(info, 0, sizeof(*info));
+    info->tensor = tensor;
+    if (!tensor) return;
+
+    info->name = g_api.tensor_name(tensor);
+    info->data = g_api.tensor_data(tensor);
+    info->byte_size = (int64_t)g_api.tensor_byte_size(tensor);
+    info->type = (int32_t)g_api.tensor_type(tensor);
+    info->num_dims = g_api.tensor_num_dims(tensor);
+    for (int32_t i = 0; i < info->num_dims && i < TFLITE_FLUTTER_MAX_DIMS; i++) {
+        info->dims[i] = g_api.tensor_dim(tensor, i);
+    }
+
+    TfLiteQuantizationParams params = g_api.tensor_quantization_params(tensor);
+    info->scale = params.scale;
+    info->zero_point = params.zero_point;
+}
+
+TfLiteStatus TfLiteFlutter_GetTensorInfos(
+    const TfLiteInterpreter* interpreter,
+    TfLiteFlutterTensorInfo* inputs, int32_t input_capacity,
+    TfLiteFlutterTensorInfo* outputs, int32_t output_capacity) {
+    if (!g_api_set || !interpreter) return kTfLiteError;
+
+    const int32_t input_count = g_api.interpreter_get_input_tensor_count(interpreter);
+    const int32_t output_count = g_api.interpreter_get_output_tensor_count(interpreter);
+    if ((input_count > 0 && !inputs) || input_count > input_capacity) return kTfLiteError;
+    if ((output_count > 0 && !outputs) || output_count > output_capacity) return kTfLiteError;
+
+    for (int32_t i = 0; i < input_count; i++) {
+        FillTensorInfo(g_api.interpreter_get_input_tensor(interpreter, i), &inputs[i]);
+    }
+    for (int32_t i = 0; i < output_count; i++) {
+        FillTensorInfo(g_api.interpreter_get_output_tensor(interpreter, i), &outputs[i]);
+    }
+    return kTfLiteOk;
+}
+
+static int64_t MonotonicNanos(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (int64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+TfLiteStatus TfLiteFlutter_Run(
+    TfLiteInterpreter* interpreter,
+    const void* const* inputs, const int64_t* input_sizes, int32_t input_count,
+    void* const* outputs, const int64_t* output_sizes, int32_t output_count,
+    TfLiteFlutterRunTiming* timing) {
+    if (!g_api_set || !interpreter || !g_api.interpreter_invoke) return kTfLiteError;
+    if (input_count > g_api.interpreter_get_input_tensor_count(interpreter)) return kTfLiteError;
+    if (output_count > g_api.interpreter_get_output_tensor_count(interpreter)) return kTfLiteError;
+
+    // Validate every buffer first so a bad call leaves the tensors untouched.
+    for (int32_t i = 0; i < input_count; i++) {
+        const TfLiteTensor* tensor = g_api.interpreter_get_input_tensor(interpreter, i);
+        if (!inputs[i] || !g_api.tensor_data(tensor) ||
+            (int64_t)g_api.tensor_byte_size(tensor) != input_sizes[i]) {
+            return kTfLiteError;
+        }
+    }
+    for (int32_t i = 0; i < output_count; i++) {
+        if (!outputs[i]) continue;
+        const TfLiteTensor* tensor = g_api.interpreter_get_output_tensor(interpreter, i);
+        if ((int64_t)g_api.tensor_byte_size(tensor) != output_sizes[i]) return kTfLiteError;
+    }
+
+    const int64_t start = MonotonicNanos();
+    for (int32_t i = 0; i < input_count; i++) {
+        const TfLiteTensor* tensor = g_api.interpreter_get_input_tensor(interpreter, i);
+        memcpy(g_api.tensor_data(tensor), inputs[i], (size_t)input_sizes[i]);
+    }
+    const int64_t copied_in = MonotonicNanos();
+
+    const TfLiteStatus status = g_api.interpreter_invoke(interpreter);
+    const int64_t invoked = MonotonicNanos();
+
+    if (status == kTfLiteOk) {
+        // Output tensors may be reallocated by invoke, so look them up again.
+        for (int32_t i = 0; i < output_count; i++) {
+            if (!outputs[i]) continue;
+            const TfLiteTensor* tensor = g_api.interpreter_get_output_tensor(interpreter, i);
+            const void* data = g_api.tensor_data(tensor);
+            if (!data || (int64_t)g_api.tensor_byte_size(tensor) != output_sizes[i]) {
+                return kTfLiteError;
+            }
+            memcpy(outputs[i], data, (size_t)output_sizes[i]);
+        }
+    }
+    const int64_t copied_out = MonotonicNanos();
+
+    if (timing) {
+        timing->copy_in_ns = copied_in - start;
+        timing->invoke_ns = invoked - copied_in;
+        timing->copy_out_ns = copied_out - invoked;
+    }
+    return status;
+}
+
+TfLiteStatus TfLiteFlutter_RunMany(
+    TfLiteInterpreter* interpreter,
+    const void* inputs, int64_t input_stride,
+    void* outputs, int64_t output_stride,
+    int32_t count, int64_t* latencies_ns, int32_t* completed) {
+    if (completed) *completed = 0;
+    if (!g_api_set || !interpreter || !g_api.interpreter_invoke) return kTfLiteError;
+    if (count < 0 || (count > 0 && (!inputs || !outputs))) return kTfLiteError;
+    if (g_api.interpreter_get_input_tensor_count(interpreter) < 1 ||
+        g_api.interpreter_get_output_tensor_count(interpreter) < 1) {
+        return kTfLiteError;
+    }
+
+    TfLiteTensor* input = g_api.interpreter_get_input_tensor(interpreter, 0);
+    void* input_data = g_api.tensor_data(input);
+    if (!input_data || (int64_t)g_api.tensor_byte_size(input) != input_stride) {
+        return kTfLiteError;
+    }
+
+    const uint8_t* src = (const uint8_t*)inputs;
+    uint8_t* dst = (uint8_t*)outputs;
+    for (int32_t i = 0; i < count; i++) {
+        const int64_t start = MonotonicNanos();
+        memcpy(input_data, src + (size_t)i * (size_t)input_stride, (size_t)input_stride);
+        const TfLiteStatus status = g_api.interpreter_invoke(interpreter);
+        if (status != kTfLiteOk) return status;
+
+        // Looked up per call since invoke may reallocate a dynamic output.
+        const TfLiteTensor* output = g_api.interpreter_get_output_tensor(interpreter, 0);
+        const void* output_data = g_api.tensor_data(output);
+        if (!output_data || (int64_t)g_api.tensor_byte_size(output) != output_stride) {
+            return kTfLiteError;
+        }
+        memcpy(dst + (size_t)i * (size_t)output_stride, output_data, (size_t)output_stride);
+
+        if (latencies_ns) latencies_ns[i] = MonotonicNanos() - start;
+        if (completed) *completed = i + 1;
+    }
+    return kTfLiteOk;
+}
+
+// Chunk size used to read a file through when prefaulting it.
+#define PREFETCH_CHUNK_BYTES (1 << 20)
+
+static int32_t PrefaultFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+    char* chunk = (char*)malloc(PREFETCH_CHUNK_BYTES);
+    if (!chunk) {
+        fclose(file);
+        return -1;
+    }
+    while (fread(chunk, 1, PREFETCH_CHUNK_BYTES, file) == PREFETCH_CHUNK_BYTES) {
+    }
+    const int32_t result = ferror(file) ? -1 : 0;
+    free(chunk);
+    fclose(file);
+    return result;
+}
+
+int32_t TfLiteFlutter_PrefetchFile(const char* path, int32_t prefault) {
+    if (!path) return -1;
+    if (prefault) return PrefaultFile(path);
+
+#if defined(_WIN32)
+    return -1;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    int32_t result = -1;
+#if defined(__APPLE__)
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size <= INT32_MAX) {
+        struct radvisory advice;
+        advice.ra_offset = 0;
+        advice.ra_count = (int)st.st_size;
+        result = fcntl(fd, F_RDADVISE, &advice) == 0 ? 0 : -1;
+    }
+#else
+    result = posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) == 0 ? 0 : -1;
+#endif
+    close(fd);
+    return result;
+#endif
+}
+
+typedef struct AsyncJob {
+    int64_t id;
+    struct AsyncJob* next;
+} AsyncJob;
+
+struct TfLiteFlutterAsyncWorker {
+    TfLiteInterpreter* interpreter;
+    TfLiteFlutterPostCObjectFn post;
+    int64_t port;
+    AsyncJob* head;
+    AsyncJob* tail;
+    int stopping;
+    int64_t thread_id;
+    int placement_pending;
+    TfLiteFlutterPlacement placement;
+#if defined(_WIN32)
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE wake;
+    HANDLE thread;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t thread;
+#endif
+};
+
+static void WorkerLock(TfLiteFlutterAsyncWorker* worker) {
+#if defined(_WIN32)
+    EnterCriticalSection(&worker->lock);
+#else
+    pthread_mutex_lock(&worker->lock);
+#endif
+}
+
+static void WorkerUnlock(TfLiteFlutterAsyncWorker* worker) {
+#if defined(_WIN32)
+    LeaveCriticalSection(&worker->lock);
+#else
+    pthread_mutex_unlock(&worker->lock);
+#endif
+}
+
+static void WorkerWait(TfLiteFlutterAsyncWorker* worker) {
+#if defined(_WIN32)
+    SleepConditionVariableCS(&worker->wake, &worker->lock, INFINITE);
+#else
+    pthread_cond_wait(&worker->wake, &worker->lock);
+#endif
+}
+
+static void WorkerWake(TfLiteFlutterAsyncWorker* worker) {
+#if defined(_WIN32)
+    WakeConditionVariable(&worker->wake);
+#else
+    pthread_cond_signal(&worker->wake);
+#endif
+}
+
+static void RunAsyncJobs(TfLiteFlutterAsyncWorker* worker) {
+    WorkerLock(worker);
+    worker->thread_id = TfLiteFlutter_CurrentThreadId();
+    WorkerUnlock(worker);
+
+    for (;;) {
+        WorkerLock(worker);
+        while (!worker->head && !worker->stopping && !worker->placement_pending) {
+            WorkerWait(worker);
+        }
+        if (worker->stopping) {
+            WorkerUnlock(worker);
+            return;
+        }
+        if (worker->placement_pending) {
+            const TfLiteFlutterPlacement placement = worker->placement;
+            worker->placement_pending = 0;
+            WorkerUnlock(worker);
+            TfLiteFlutter_SetThreadPlacement(0, &placement);
+            continue;
+        }
+        AsyncJob* job = worker->head;
+        worker->head = job->next;
+        if (!worker->head) worker->tail = NULL;
+        WorkerUnlock(worker);
+
+        const TfLiteStatus status = g_api.interpreter_invoke(worker->interpreter);
+        TfLiteFlutterCObject message;
+        message.type = TFLITE_FLUTTER_COBJECT_INT64;
+        message.value.as_int64 = (job->id << 8) | ((int64_t)status & 0xff);
+        worker->post(worker->port, &message);
+        free(job);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI AsyncWorkerMain(LPVOID arg) {
+    RunAsyncJobs((TfLiteFlutterAsyncWorker*)arg);
+    return 0;
+}
+#else
+static void* AsyncWorkerMain(void* arg) {
+    RunAsyncJobs((TfLiteFlutterAsyncWorker*)arg);
+    return NULL;
+}
+#endif
+
+TfLiteFlutterAsyncWorker* TfLiteFlutter_AsyncWorkerCreate(
+    TfLiteInterpreter* interpreter, TfLiteFlutterPostCObjectFn post, int64_t port) {
+    if (!g_api_set || !interpreter || !post || !g_api.interpreter_invoke) return NULL;
+    TfLiteFlutterAsyncWorker* worker =
+        (TfLiteFlutterAsyncWorker*)calloc(1, sizeof(TfLiteFlutterAsyncWorker));
+    if (!worker) return NULL;
+    worker->interpreter = interpreter;
+    worker->post = post;
+    worker->port = port;
+
+#if defined(_WIN32)
+    InitializeCriticalSection(&worker->lock);
+    InitializeConditionVariable(&worker->wake);
+    worker->thread = CreateThread(NULL, 0, AsyncWorkerMain, worker, 0, NULL);
+    if (!worker->thread) {
+        DeleteCriticalSection(&worker->lock);
+        free(worker);
+        return NULL;
+    }
+#else
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->wake, NULL);
+    if (pthread_create(&worker->thread, NULL, AsyncWorkerMain, worker) != 0) {
+        pthread_cond_destroy(&worker->wake);
+        pthread_mutex_destroy(&worker->lock);
+        free(worker);
+        return NULL;
+    }
+#endif
+    return worker;
+}
+
+int32_t TfLiteFlutter_AsyncWorkerSubmit(TfLiteFlutterAsyncWorker* worker, int64_t job_id) {
+    if (!worker) return -1;
+    AsyncJob* job = (AsyncJob*)malloc(sizeof(AsyncJob));
+    if (!job) return -1;
+    job->id = job_id;
+    job->next = NULL;
+
+    WorkerLock(worker);
+    if (worker->stopping) {
+        WorkerUnlock(worker);
+        free(job);
+        return -1;
+    }
+    if (worker->tail) {
+        worker->tail->next = job;
+    } else {
+        worker->head = job;
+    }
+    worker->tail = job;
+    WorkerWake(worker);
+    WorkerUnlock(worker);
+    return 0;
+}
+
+void TfLiteFlutter_AsyncWorkerDelete(TfLiteFlutterAsyncWorker* worker) {
+    if (!worker) return;
+    WorkerLock(worker);
+    worker->stopping = 1;
+    WorkerWake(worker);
+    WorkerUnlock(worker);
+
+#if defined(_WIN32)
+    WaitForSingleObject(worker->thread, INFINITE);
+    CloseHandle(worker->thread);
+    DeleteCriticalSection(&worker->lock);
+#else
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+#endif
+
+    AsyncJob* job = worker->head;
+    while (job) {
+        AsyncJob* next = job->next;
+        free(job);
+        job = next;
+    }
+    free(worker);
+}
+
+int32_t TfLiteFlutter_AsyncWorkerSetPlacement(
+    TfLiteFlutterAsyncWorker* worker, const TfLiteFlutterPlacement* placement) {
+    if (!worker || !placement) return -1;
+    WorkerLock(worker);
+    if (worker->stopping) {
+        WorkerUnlock(worker);
+        return -1;
+    }
+    worker->placement = *placement;
+    worker->placement_pending = 1;
+    WorkerWake(worker);
+    WorkerUnlock(worker);
+    return 0;
+}
+
+int64_t TfLiteFlutter_AsyncWorkerThreadId(TfLiteFlutterAsyncWorker* worker) {
+    if (!worker) return 0;
+    WorkerLock(worker);
+    const int64_t thread_id = worker->thread_id;
+    WorkerUnlock(worker);
+    return thread_id;
+}
+
+#if defined(_WIN32)
+static SRWLOCK g_thread_budget_lock = SRWLOCK_INIT;
+#define LockThreadBudget() AcquireSRWLockExclusive(&g_thread_budget_lock)
+#define UnlockThreadBudget() ReleaseSRWLockExclusive(&g_thread_budget_lock)
+#else
+static pthread_mutex_t g_thread_budget_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LockThreadBudget() pthread_mutex_lock(&g_thread_budget_lock)
+#define UnlockThreadBudget() pthread_mutex_unlock(&g_thread_budget_lock)
+#endif
+
+static int32_t g_thread_budget = -1;
+static int32_t g_threads_in_use = 0;
+
+void TfLiteFlutter_SetThreadBudget(int32_t max_threads) {
+    LockThreadBudget();
+    g_thread_budget = max_threads > 0 ? max_threads : 0;
+    UnlockThreadBudget();
+}
+
+int32_t TfLiteFlutter_GetThreadBudget(void) {
+    LockThreadBudget();
+    const int32_t budget = g_thread_budget;
+    UnlockThreadBudget();
+    return budget;
+}
+
+int32_t TfLiteFlutter_AcquireThreads(int32_t requested) {
+    if (requested <= 1) return 1;
+    LockThreadBudget();
+    const int32_t available = g_thread_budget - g_threads_in_use;
+    int32_t extra = requested - 1;
+    if (extra > available) extra = available > 0 ? available : 0;
+    g_threads_in_use += extra;
+    UnlockThreadBudget();
+    return 1 + extra;
+}
+
+void TfLiteFlutter_ReleaseThreads(int32_t granted) {
+    if (granted <= 1) return;
+    LockThreadBudget();
+    g_threads_in_use -= granted - 1;
+    if (g_threads_in_use < 0) g_threads_in_use = 0;
+    UnlockThreadBudget();
+}
+
+int32_t TfLiteFlutter_ThreadsInUse(void) {
+    LockThreadBudget();
+    const int32_t in_use = g_threads_in_use;
+    UnlockThreadBudget();
+    return in_use;
+}
+
+#if defined(__linux__)
+
+static pid_t ResolveThreadId(int64_t tid) {
+    return tid != 0 ? (pid_t)tid : (pid_t)syscall(SYS_gettid);
+}
+
+static void MaskToCpuSet(const uint64_t* cpus, cpu_set_t* set) {
+    CPU_ZERO(set);
+    for (int cpu = 0; cpu < TFLITE_FLUTTER_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (cpus[cpu / 64] & ((uint64_t)1 << (cpu % 64))) CPU_SET(cpu, set);
+    }
+}
+
+static void CpuSetToMask(const cpu_set_t* set, uint64_t* cpus) {
+    memset(cpus, 0, sizeof(uint64_t) * (TFLITE_FLUTTER_MAX_CPUS / 64));
+    for (int cpu = 0; cpu < TFLITE_FLUTTER_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, set)) cpus[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+    }
+}
+
+static int ToSchedPolicy(int32_t policy) {
+    switch (policy) {
+#if defined(SCHED_BATCH)
+        case TFLITE_FLUTTER_POLICY_BATCH:
+            return SCHED_BATCH;
+#endif
+#if defined(SCHED_IDLE)
+        case TFLITE_FLUTTER_POLICY_IDLE:
+            return SCHED_IDLE;
+#endif
+        case TFLITE_FLUTTER_POLICY_NORMAL:
+            return SCHED_OTHER;
+        default:
+            return -1;
+    }
+}
+
+static int32_t FromSchedPolicy(int policy) {
+#if defined(SCHED_BATCH)
+    if (policy == SCHED_BATCH) return TFLITE_FLUTTER_POLICY_BATCH;
+#endif
+#if defined(SCHED_IDLE)
+    if (policy == SCHED_IDLE) return TFLITE_FLUTTER_POLICY_IDLE;
+#endif
+    return TFLITE_FLUTTER_POLICY_NORMAL;
+}
+
+int64_t TfLiteFlutter_CurrentThreadId(void) {
+    return (int64_t)syscall(SYS_gettid);
+}
+
+int32_t TfLiteFlutter_ListThreads(int64_t* tids, int32_t capacity) {
+    DIR* dir = opendir("/proc/self/task");
+    if (!dir) return -1;
+    int32_t count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+        if (tids && count < capacity) tids[count] = strtoll(entry->d_name, NULL, 10);
+        count++;
+    }
+    closedir(dir);
+    return count;
+}
+
+int32_t TfLiteFlutter_SetThreadPlacement(int64_t tid, const TfLiteFlutterPlacement* placement) {
+    if (!placement) return EINVAL;
+    const pid_t thread = ResolveThreadId(tid);
+    int32_t result = 0;
+    if (placement->flags & TFLITE_FLUTTER_PLACE_CPUS) {
+        cpu_set_t set;
+        MaskToCpuSet(placement->cpus, &set);
+        if (sched_setaffinity(thread, sizeof(set), &set) != 0 && result == 0) result = errno;
+    }
+    // The policy goes first: SCHED_IDLE ignores niceness, and leaving it
+    // resets the thread to its previous niceness.
+    if (placement->flags & TFLITE_FLUTTER_PLACE_POLICY) {
+        const int policy = ToSchedPolicy(placement->policy);
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        if (policy < 0) {
+            if (result == 0) result = EINVAL;
+        } else if (sched_setscheduler(thread, policy, &param) != 0 && result == 0) {
+            result = errno;
+        }
+    }
+    if (placement->flags & TFLITE_FLUTTER_PLACE_NICE) {
+        if (setpriority(PRIO_PROCESS, (id_t)thread, placement->nice) != 0 && result == 0) {
+            result = errno;
+        }
+    }
+    return result;
+}
+
+int32_t TfLiteFlutter_GetThreadPlacement(int64_t tid, TfLiteFlutterPlacement* placement) {
+    if (!placement) return EINVAL;
+    memset(placement, 0, sizeof(*placement));
+    const pid_t thread = ResolveThreadId(tid);
+    cpu_set_t set;
+    if (sched_getaffinity(thread, sizeof(set), &set) != 0) return errno;
+    CpuSetToMask(&set, placement->cpus);
+    errno = 0;
+    const int nice = getpriority(PRIO_PROCESS, (id_t)thread);
+    if (nice == -1 && errno != 0) return errno;
+    const int policy = sched_getscheduler(thread);
+    if (policy < 0) return errno;
+    placement->nice = nice;
+    placement->policy = FromSchedPolicy(policy);
+    placement->flags =
+        TFLITE_FLUTTER_PLACE_CPUS | TFLITE_FLUTTER_PLACE_NICE | TFLITE_FLUTTER_PLACE_POLICY;
+    return 0;
+}
+
+int32_t TfLiteFlutter_SwapThreadAffinity(
+    const TfLiteFlutterPlacement* placement, TfLiteFlutterPlacement* previous) {
+    if (!placement || !previous) return EINVAL;
+    memset(previous, 0, sizeof(*previous));
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return errno;
+    CpuSetToMask(&set, previous->cpus);
+    previous->flags = TFLITE_FLUTTER_PLACE_CPUS;
+    MaskToCpuSet(placement->cpus, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        previous->flags = 0;
+        return errno;
+    }
+    return 0;
+}
+
+#else
+
+int64_t TfLiteFlutter_CurrentThreadId(void) {
+    return 0;
+}
+
+int32_t TfLiteFlutter_ListThreads(int64_t* tids, int32_t capacity) {
+    (void)tids;
+    (void)capacity;
+    return -1;
+}
+
+int32_t TfLiteFlutter_SetThreadPlacement(int64_t tid, const TfLiteFlutterPlacement* placement) {
+    (void)tid;
+    (void)placement;
+    return -1;
+}
+
+int32_t TfLiteFlutter_GetThreadPlacement(int64_t tid, TfLiteFlutterPlacement* placement) {
+    (void)tid;
+    if (placement) memset(placement, 0, sizeof(*placement));
+    return -1;
+}
+
+int32_t TfLiteFlutter_SwapThreadAffinity(
+    const TfLiteFlutterPlacement* placement, TfLiteFlutterPlacement* previous) {
+    (void)placement;
+    if (previous) memset(previous, 0, sizeof(*previous));
+    return -1;
+}
+
+#endif
@@ -0,0 +1,265 @@
+// Copyright 2025 flutter_litert authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Runtime helpers that batch work which would otherwise need many Dart FFI
+// transitions into the TFLite C API.
+//
+// This library is not linked against TFLite: the TFLite library is loaded by
+// Dart with platform-specific names and flags, so Dart resolves the C API
+// entry points and hands them over once with TfLiteFlutter_SetApi().
+
+#ifndef TFLITE_FLUTTER_RUNTIME_H_
+#define TFLITE_FLUTTER_RUNTIME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Platform-specific TFLite header includes
+#if (defined(__APPLE__) && TARGET_OS_IOS) || defined(TFLITE_USE_FRAMEWORK_HEADERS)
+// iOS: Use framework headers from CocoaPods
+#include <TensorFlowLiteC/TensorFlowLiteC.h>
+#else
+// Desktop: Use headers from local path (set via CMake/header search paths)
+#include "tensorflow_lite/c_api.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Symbol export for dynamic lookup via FFI
+#if defined(_WIN32)
+#define TFLITE_FLUTTER_RUNTIME_EXPORT __declspec(dllexport)
+#else
+#define TFLITE_FLUTTER_RUNTIME_EXPORT __attribute__((used, visibility("default")))
+#endif
+
+// Maximum number of dimensions reported inline by TfLiteFlutterTensorInfo.
+#define TFLITE_FLUTTER_MAX_DIMS 8
+
+// TFLite C API entry points used by the runtime helpers. Filled in by Dart
+// from the already-loaded TFLite library. New entries are only ever appended.
+typedef struct TfLiteFlutterApi {
+    int32_t (*interpreter_get_input_tensor_count)(const TfLiteInterpreter*);
+    TfLiteTensor* (*interpreter_get_input_tensor)(const TfLiteInterpreter*, int32_t);
+    int32_t (*interpreter_get_output_tensor_count)(const TfLiteInterpreter*);
+    const TfLiteTensor* (*interpreter_get_output_tensor)(const TfLiteInterpreter*, int32_t);
+    TfLiteType (*tensor_type)(const TfLiteTensor*);
+    int32_t (*tensor_num_dims)(const TfLiteTensor*);
+    int32_t (*tensor_dim)(const TfLiteTensor*, int32_t);
+    size_t (*tensor_byte_size)(const TfLiteTensor*);
+    void* (*tensor_data)(const TfLiteTensor*);
+    const char* (*tensor_name)(const TfLiteTensor*);
+    TfLiteQuantizationParams (*tensor_quantization_params)(const TfLiteTensor*);
+    TfLiteStatus (*interpreter_invoke)(TfLiteInterpreter*);
+} TfLiteFlutterApi;
+
+// Snapshot of one tensor's metadata.
+//
+// `num_dims` is always the real rank; only the first TFLITE_FLUTTER_MAX_DIMS
+// entries of `dims` are filled.
+typedef struct TfLiteFlutterTensorInfo {
+    const TfLiteTensor* tensor;
+    const char* name;
+    void* data;
+    int64_t byte_size;
+    int32_t type;
+    int32_t num_dims;
+    int32_t dims[TFLITE_FLUTTER_MAX_DIMS];
+    float scale;
+    int32_t zero_point;
+} TfLiteFlutterTensorInfo;
+
+// Installs the TFLite C API entry points. `api` is copied. Must be called
+// before any other function in this file.
+TFLITE_FLUTTER_RUNTIME_EXPORT void TfLiteFlutter_SetApi(const TfLiteFlutterApi* api);
+
+// Fills `inputs` and `outputs` with the metadata of every input and output
+// tensor of `interpreter` in a single call.
+//
+// The capacities must be at least the interpreter's input and output tensor
+// counts. Returns kTfLiteError if the API is not installed or a capacity is
+// too small.
+TFLITE_FLUTTER_RUNTIME_EXPORT TfLiteStatus TfLiteFlutter_GetTensorInfos(
+    const TfLiteInterpreter* interpreter,
+    TfLiteFlutterTensorInfo* inputs, int32_t input_capacity,
+    TfLiteFlutterTensorInfo* outputs, int32_t output_capacity);
+
+// Per-phase durations of TfLiteFlutter_Run, measured with a monotonic clock.
+typedef struct TfLiteFlutterRunTiming {
+    int64_t copy_in_ns;
+    int64_t invoke_ns;
+    int64_t copy_out_ns;
+} TfLiteFlutterRunTiming;
+
+// Copies `input_count` buffers into the input tensors, invokes the
+// interpreter and copies the outputs into `outputs`, all in one call.
+//
+// `input_sizes[i]` must equal the byte size of input tensor i. A null
+// `outputs[i]` skips output i; otherwise `output_sizes[i]` must equal the
+// byte size of output tensor i. `timing` may be null. Returns kTfLiteError on
+// a size mismatch (before anything is copied), or the status of invoke.
+TFLITE_FLUTTER_RUNTIME_EXPORT TfLiteStatus TfLiteFlutter_Run(
+    TfLiteInterpreter* interpreter,
+    const void* const* inputs, const int64_t* input_sizes, int32_t input_count,
+    void* const* outputs, const int64_t* output_sizes, int32_t output_count,
+    TfLiteFlutterRunTiming* timing);
+
+// Runs `count` back-to-back inferences on input tensor 0 and output tensor 0.
+//
+// Invocation i copies `input_stride` bytes from `inputs + i * input_stride`
+// into input tensor 0, invokes, and copies output tensor 0 to
+// `outputs + i * output_stride`. The strides must equal the tensors' byte
+// sizes. When `latencies_ns` is not null it receives the duration of each
+// invocation (copy-in, invoke and copy-out). Stops at the first failing
+// invoke; `completed` (may be null) receives the number of finished calls.
+TFLITE_FLUTTER_RUNTIME_EXPORT TfLiteStatus TfLiteFlutter_RunMany(
+    TfLiteInterpreter* interpreter,
+    const void* inputs, int64_t input_stride,
+    void* outputs, int64_t output_stride,
+    int32_t count, int64_t* latencies_ns, int32_t* completed);
+
+// Warms the page cache for the model file at `path` before it is mapped.
+//
+// With `prefault` unset this only advises the kernel that the whole file will
+// be needed soon (POSIX_FADV_WILLNEED, or F_RDADVISE on Apple platforms) and
+// returns immediately. With `prefault` set the file is read through once,
+// blocking until it is resident. Returns 0 on success and -1 on failure or
+// when the platform offers no such advice.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_PrefetchFile(const char* path, int32_t prefault);
+
+// Leading part of Dart_CObject from dart_native_api.h, enough to post an
+// int64 message without depending on the Dart SDK headers.
+#define TFLITE_FLUTTER_COBJECT_INT64 3
+
+typedef struct TfLiteFlutterCObject {
+    int32_t type;
+    union {
+        int64_t as_int64;
+        double as_double;
+        void* as_pointer;
+    } value;
+} TfLiteFlutterCObject;
+
+// Signature of Dart_PostCObject, as exposed to Dart by NativeApi.postCObject.
+typedef bool (*TfLiteFlutterPostCObjectFn)(int64_t port, TfLiteFlutterCObject* message);
+
+// Native thread running queued invokes of one interpreter.
+typedef struct TfLiteFlutterAsyncWorker TfLiteFlutterAsyncWorker;
+
+// Starts a worker thread for `interpreter`. Completions are posted to the
+// Dart port `port` with `post`. Returns null if the API is not installed or
+// the thread cannot be started.
+TFLITE_FLUTTER_RUNTIME_EXPORT TfLiteFlutterAsyncWorker* TfLiteFlutter_AsyncWorkerCreate(
+    TfLiteInterpreter* interpreter, TfLiteFlutterPostCObjectFn post, int64_t port);
+
+// Queues one invoke. Jobs run in submission order; when a job finishes the
+// int64 `(job_id << 8) | status` is posted to the worker's port. Returns 0,
+// or -1 if the job cannot be queued.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_AsyncWorkerSubmit(
+    TfLiteFlutterAsyncWorker* worker, int64_t job_id);
+
+// Stops the worker: waits for the running invoke, if any, discards queued
+// jobs without posting them and joins the thread.
+TFLITE_FLUTTER_RUNTIME_EXPORT void TfLiteFlutter_AsyncWorkerDelete(TfLiteFlutterAsyncWorker* worker);
+
+// Process-wide budget of compute threads shared by every interpreter and
+// delegate, so concurrent models do not oversubscribe the cores.
+//
+// Each client always runs on its calling thread; the budget caps the extra
+// pool threads. Sets the cap on extra threads; clients holding more than the
+// new cap keep them until released.
+TFLITE_FLUTTER_RUNTIME_EXPORT void TfLiteFlutter_SetThreadBudget(int32_t max_threads);
+
+// Returns the current cap on extra threads, or -1 until one is set. No
+// extra threads are granted before a cap is set.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_GetThreadBudget(void);
+
+// Grants up to `requested` threads, the calling thread included: the result
+// is between 1 and `requested` and must be passed back to
+// TfLiteFlutter_ReleaseThreads.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_AcquireThreads(int32_t requested);
+
+// Returns threads granted by TfLiteFlutter_AcquireThreads.
+TFLITE_FLUTTER_RUNTIME_EXPORT void TfLiteFlutter_ReleaseThreads(int32_t granted);
+
+// Returns the number of extra threads currently granted.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_ThreadsInUse(void);
+
+// Number of CPUs addressable by TfLiteFlutterPlacement.
+#define TFLITE_FLUTTER_MAX_CPUS 1024
+
+// Bits of TfLiteFlutterPlacement.flags naming the fields to apply.
+#define TFLITE_FLUTTER_PLACE_CPUS 1
+#define TFLITE_FLUTTER_PLACE_NICE 2
+#define TFLITE_FLUTTER_PLACE_POLICY 4
+
+// Values of TfLiteFlutterPlacement.policy: SCHED_OTHER, SCHED_BATCH and
+// SCHED_IDLE.
+#define TFLITE_FLUTTER_POLICY_NORMAL 0
+#define TFLITE_FLUTTER_POLICY_BATCH 1
+#define TFLITE_FLUTTER_POLICY_IDLE 2
+
+// CPU affinity, niceness and scheduling policy of one thread. CPU i is bit
+// i % 64 of `cpus[i / 64]`.
+typedef struct TfLiteFlutterPlacement {
+    int32_t flags;
+    int32_t nice;
+    int32_t policy;
+    int32_t reserved;
+    uint64_t cpus[TFLITE_FLUTTER_MAX_CPUS / 64];
+} TfLiteFlutterPlacement;
+
+// Thread placement is only implemented on Linux and Android. Elsewhere the
+// functions below return -1 (or 0 for thread ids) and change nothing.
+
+// Returns the kernel id of the calling thread.
+TFLITE_FLUTTER_RUNTIME_EXPORT int64_t TfLiteFlutter_CurrentThreadId(void);
+
+// Writes the ids of up to `capacity` threads of this process to `tids` and
+// returns the total number of threads, or -1 on failure.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_ListThreads(int64_t* tids, int32_t capacity);
+
+// Applies the fields of `placement` selected by its flags to thread `tid`
+// (0 for the calling thread). Every field is attempted; returns 0, or the
+// errno of the first one that failed. Raising niceness or leaving
+// SCHED_IDLE again usually needs CAP_SYS_NICE or RLIMIT_NICE.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_SetThreadPlacement(
+    int64_t tid, const TfLiteFlutterPlacement* placement);
+
+// Reads the affinity, niceness and policy of thread `tid` (0 for the calling
+// thread) into `placement`, with every flag set. Returns 0 or an errno.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_GetThreadPlacement(
+    int64_t tid, TfLiteFlutterPlacement* placement);
+
+// Saves the calling thread's affinity to `previous` and restricts it to the
+// CPUs of `placement`, for the duration of one invocation; restore it with
+// TfLiteFlutter_SetThreadPlacement(0, previous). Returns 0 or an errno.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_SwapThreadAffinity(
+    const TfLiteFlutterPlacement* placement, TfLiteFlutterPlacement* previous);
+
+// Makes the worker thread apply `placement` before running further jobs.
+// `placement` is copied. Returns 0, or -1 if the worker is stopping.
+TFLITE_FLUTTER_RUNTIME_EXPORT int32_t TfLiteFlutter_AsyncWorkerSetPlacement(
+    TfLiteFlutterAsyncWorker* worker, const TfLiteFlutterPlacement* placement);
+
+// Returns the kernel id of the worker thread, or 0 until it has started.
+TFLITE_FLUTTER_RUNTIME_EXPORT int64_t TfLiteFlutter_AsyncWorkerThreadId(TfLiteFlutterAsyncWorker* worker);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TFLITE_FLUTTER_RUNTIME_H_
@@ -0,0 +1,71 @@
+import 'dart:io';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+void main() {
+  group('TuningCandidate', () {
+    test('names the configuration', () {
+      expect(const TuningCandidate(threads: 4).id, 'cpu-t4');
+      expect(
+          const TuningCandidate(threads: 2, xnnpack: true, forceFP16: true).id,
+          'xnnpack-t2-fp16');
+      expect(const TuningCandidate(enableQS8: true).id, 'cpu-t1');
+    });
+
+    test('compares every field', () {
+      expect(const TuningCandidate(enableQS8: true),
+          isNot(TuningCandidate.baseline));
+      expect(const TuningCandidate(threads: 2, xnnpack: true, forceFP16: true),
+          const TuningCandidate(threads: 2, xnnpack: true, forceFP16: true));
+      expect(const TuningCandidate(threads: 2, xnnpack: true).hashCode,
+          const TuningCandidate(threads: 2, xnnpack: true).hashCode);
+    });
+
+    test('round-trips through JSON', () {
+      const candidate = TuningCandidate(
+          threads: 3, xnnpack: true, enableQS8: true, enableQU8: true);
+      final restored = TuningCandidate.fromJson(candidate.toJson());
+      expect(restored, candidate);
+      expect(restored.enableQU8, isTrue);
+      expect(restored.forceFP16, isFalse);
+    });
+
+    test('defaults cover powers of two up to the thread limit', () {
+      final candidates = TuningCandidate.defaults(maxThreads: 6);
+      expect(candidates.map((c) => c.threads).toSet(), {1, 2, 4, 6});
+      expect(candidates, contains(TuningCandidate.baseline));
+      expect(candidates.toSet().length, candidates.length);
+    });
+  });
+
+  group('Interpreter.autoTune', () {
+    test('stores the winner in the given directory', () async {
+      final directory = await Directory.systemTemp.createTemp('auto_tune_test');
+      final model = Model.fromFile('test/fixtures/scale.tflite');
+      const candidates = [
+        TuningCandidate.baseline,
+        TuningCandidate(threads: 2),
+      ];
+      try {
+        final measured = await Interpreter.autoTune(model,
+            candidates: candidates,
+            warmUpRuns: 1,
+            timedRuns: 3,
+            directory: directory);
+        expect(measured.fromStore, isFalse);
+        expect(measured.measurements, isNotEmpty);
+        expect(candidates, contains(measured.best));
+        expect(directory.listSync(), hasLength(1));
+
+        final stored = await Interpreter.autoTune(model,
+            candidates: candidates, directory: directory);
+        expect(stored.fromStore, isTrue);
+        expect(stored.best, measured.best);
+      } finally {
+        model.delete();
+        await directory.delete(recursive: true);
+      }
+    });
+  });
+}
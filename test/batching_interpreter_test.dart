@@ -0,0 +1,136 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+// Doubles a float32 [n, 2] input; see test/interpreter_test.dart.
+BatchingInterpreter _createBatcher(int maxBatchSize, Duration maxDelay) {
+  final model = Model.fromFile('test/fixtures/scale.tflite');
+  try {
+    return BatchingInterpreter.create(model,
+        maxBatchSize: maxBatchSize, maxDelay: maxDelay);
+  } finally {
+    model.delete();
+  }
+}
+
+Future<List<double>> _run(BatchingInterpreter batcher, double value) async {
+  final outputs = await batcher.run([
+    Float32List.fromList([value, value + 1])
+  ]);
+  expect(outputs.single.shape, [1, 2]);
+  return List.of(outputs.single.data as Float32List);
+}
+
+void main() {
+  group('BatchingInterpreter', () {
+    test('packs samples back to back along dimension 0', () async {
+      final images = Float32List(6);
+      final ids = Int32List(3);
+      final samples = [
+        [Float32List.fromList([1, 2]), Int32List.fromList([7])],
+        [Float32List.fromList([3, 4]), Int32List.fromList([8])],
+        [Float32List.fromList([5, 6]), Int32List.fromList([9])],
+      ];
+      BatchingInterpreter.pack(samples, [images, ids]);
+      expect(images, [1, 2, 3, 4, 5, 6]);
+      expect(ids, [7, 8, 9]);
+    });
+
+    test('splits outputs into one copy per sample', () async {
+      final scores = TensorView(
+          Float32List.fromList([0.1, 0.9, 0.6, 0.4, 0.3, 0.7]), [3, 2]);
+      final labels = TensorView(Int8List.fromList([1, 0, 1]), [3]);
+      final samples = BatchingInterpreter.split([scores, labels], 3);
+      expect(samples.length, 3);
+      for (final outputs in samples) {
+        expect(outputs[0].shape, [1, 2]);
+        expect(outputs[1].shape, [1]);
+        expect(outputs[0].type, TensorType.float32);
+        expect(outputs[1].type, TensorType.int8);
+        expect(identical(outputs[0].data, scores.data), isFalse);
+      }
+      expect(samples[1][0].toList(), [
+        [closeTo(0.6, 1e-6), closeTo(0.4, 1e-6)]
+      ]);
+      expect(samples[2][1].toList(), [1]);
+    });
+  });
+
+  group('BatchingInterpreter.run', () {
+    late BatchingInterpreter batcher;
+
+    tearDown(() async {
+      await batcher.close();
+    });
+
+    test('flushes as soon as maxBatchSize requests are pending', () async {
+      batcher = _createBatcher(4, const Duration(hours: 1));
+      final results = [for (var i = 0; i < 4; i++) _run(batcher, i * 10.0)];
+      expect(await Future.wait(results), [
+        [0.0, 2.0],
+        [20.0, 22.0],
+        [40.0, 42.0],
+        [60.0, 62.0],
+      ]);
+      expect(batcher.batchCount, 1);
+      expect(batcher.sampleCount, 4);
+      expect(batcher.cachedBatchSizes, unorderedEquals([1, 4]));
+    });
+
+    test('flushes a partial batch after maxDelay', () async {
+      batcher = _createBatcher(8, const Duration(milliseconds: 20));
+      final results = [for (var i = 0; i < 3; i++) _run(batcher, i * 1.0)];
+      await Future<void>.delayed(Duration.zero);
+      expect(batcher.batchCount, 0);
+      expect(await Future.wait(results), [
+        [0.0, 2.0],
+        [2.0, 4.0],
+        [4.0, 6.0],
+      ]);
+      expect(batcher.batchCount, 1);
+      expect(batcher.cachedBatchSizes, unorderedEquals([1, 3]));
+    });
+
+    test('runs requests beyond maxBatchSize in a later batch', () async {
+      batcher = _createBatcher(4, const Duration(milliseconds: 5));
+      final results = [for (var i = 0; i < 6; i++) _run(batcher, i * 1.0)];
+      final outputs = await Future.wait(results);
+      for (var i = 0; i < 6; i++) {
+        expect(outputs[i], [i * 2.0, i * 2.0 + 2]);
+      }
+      expect(batcher.batchCount, 2);
+      expect(batcher.sampleCount, 6);
+      expect(batcher.cachedBatchSizes, unorderedEquals([1, 4, 2]));
+    });
+
+    test('reuses the interpreter cached for a batch size', () async {
+      batcher = _createBatcher(2, const Duration(hours: 1));
+      for (var round = 0; round < 3; round++) {
+        final results = [_run(batcher, round * 1.0), _run(batcher, -1)];
+        expect(await Future.wait(results), [
+          [round * 2.0, round * 2.0 + 2],
+          [-2.0, 0.0],
+        ]);
+      }
+      expect(batcher.batchCount, 3);
+      expect(batcher.cachedBatchSizes, unorderedEquals([1, 2]));
+    });
+
+    test('rejects inputs that do not hold one sample', () async {
+      batcher = _createBatcher(4, const Duration(milliseconds: 5));
+      expect(() => batcher.run([Float32List(4)]), throwsArgumentError);
+      expect(() => batcher.run([Float32List(2), Float32List(2)]),
+          throwsArgumentError);
+      expect(batcher.sampleCount, 0);
+    });
+
+    test('fails pending requests on close', () async {
+      batcher = _createBatcher(4, const Duration(hours: 1));
+      final failed = expectLater(_run(batcher, 1), throwsStateError);
+      await batcher.close();
+      await failed;
+      expect(() => batcher.run([Float32List(2)]), throwsStateError);
+    });
+  });
+}
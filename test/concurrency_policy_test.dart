@@ -0,0 +1,71 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+ConcurrencySample _sample(double depth, int interpreters, int p95) =>
+    ConcurrencySample(
+        requests: 100,
+        meanQueueDepth: depth,
+        interpreters: interpreters,
+        p95Micros: p95);
+
+void main() {
+  test('levels halve the threads per interpreter', () {
+    expect(ConcurrencyLevel.levelsFor(8), const [
+      ConcurrencyLevel(1, 8),
+      ConcurrencyLevel(2, 4),
+      ConcurrencyLevel(4, 2),
+      ConcurrencyLevel(8, 1),
+    ]);
+    expect(ConcurrencyLevel.levelsFor(6), const [
+      ConcurrencyLevel(1, 6),
+      ConcurrencyLevel(2, 3),
+      ConcurrencyLevel(6, 1),
+    ]);
+    expect(ConcurrencyLevel.levelsFor(1), const [ConcurrencyLevel(1, 1)]);
+  });
+
+  group('ConcurrencyPolicy', () {
+    test('adds interpreters while requests queue and threads while idle', () {
+      final policy = ConcurrencyPolicy();
+      expect(policy.next(0, 4, _sample(3, 1, 1000)), 1);
+      expect(policy.next(1, 4, _sample(1.5, 2, 900)), 1);
+      expect(policy.next(1, 4, _sample(0.2, 2, 900)), 0);
+      expect(policy.next(0, 4, _sample(0.2, 1, 500)), 0);
+    });
+
+    test('stays put without requests or at the ends', () {
+      final policy = ConcurrencyPolicy();
+      expect(
+          policy.next(
+              2,
+              4,
+              const ConcurrencySample(
+                  requests: 0,
+                  meanQueueDepth: 0,
+                  interpreters: 4,
+                  p95Micros: 0)),
+          2);
+      expect(policy.next(3, 4, _sample(10, 8, 1000)), 3);
+    });
+
+    test('undoes a move that slows requests and holds off', () {
+      final policy = ConcurrencyPolicy(holdIntervals: 2);
+      expect(policy.next(0, 4, _sample(2, 1, 1000)), 1);
+      // Same load, much slower: revert.
+      expect(policy.next(1, 4, _sample(2, 2, 2000)), 0);
+      // Still queueing, but growing is held off.
+      expect(policy.next(0, 4, _sample(2, 1, 1000)), 0);
+      expect(policy.next(0, 4, _sample(2, 1, 1000)), 0);
+      expect(policy.next(0, 4, _sample(2, 1, 1000)), 1);
+    });
+
+    test('does not judge a move that failed', () {
+      final policy = ConcurrencyPolicy();
+      expect(policy.next(0, 4, _sample(2, 1, 1000)), 1);
+      policy.moveFailed();
+      // Still at level 0 and slower: without the failure report this would
+      // count as a regression of the move and hold off growing.
+      expect(policy.next(0, 4, _sample(2, 1, 3000)), 1);
+    });
+  });
+}
@@ -0,0 +1,88 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+void main() {
+  group('InputBucketing', () {
+    test('picks the smallest bucket holding the size', () {
+      final bucketing =
+          InputBucketing(inputIndex: 0, axis: 1, buckets: [64, 16, 128, 32]);
+      expect(bucketing.buckets, [16, 32, 64, 128]);
+      expect(bucketing.bucketFor(1), 16);
+      expect(bucketing.bucketFor(16), 16);
+      expect(bucketing.bucketFor(17), 32);
+      expect(bucketing.bucketFor(128), 128);
+    });
+
+    test('rejects sizes above the largest bucket', () {
+      final bucketing =
+          InputBucketing(inputIndex: 0, axis: 1, buckets: [16, 32]);
+      expect(() => bucketing.bucketFor(33), throwsArgumentError);
+    });
+
+    test('rejects empty or non-positive buckets', () {
+      expect(() => InputBucketing(inputIndex: 0, axis: 0, buckets: []),
+          throwsArgumentError);
+      expect(() => InputBucketing(inputIndex: 0, axis: 0, buckets: [0, 8]),
+          throwsArgumentError);
+    });
+  });
+
+  group('ShapeCachedInterpreter', () {
+    test('pads one axis and fills the rest with the pad value', () {
+      final input =
+          TensorView(Float32List.fromList([1, 2, 3, 4, 5, 6]), [2, 3]);
+      final target = Float32List(8);
+      ShapeCachedInterpreter.pad(input, target, [2, 4], -1);
+      expect(target, [1, 2, 3, -1, 4, 5, 6, -1]);
+    });
+
+    test('pads several axes at once', () {
+      final input =
+          TensorView(Int32List.fromList([1, 2, 3, 4, 5, 6]), [1, 2, 3]);
+      final target = Int32List(2 * 3 * 4);
+      ShapeCachedInterpreter.pad(input, target, [2, 3, 4], 0);
+      expect(target.sublist(0, 12), [1, 2, 3, 0, 4, 5, 6, 0, 0, 0, 0, 0]);
+      expect(target.sublist(12), everyElement(0));
+    });
+
+    test('pads strided views', () {
+      final input =
+          TensorView(Int32List.fromList([1, 2, 3, 4]), [2, 2]).transpose();
+      final target = Int32List(6);
+      ShapeCachedInterpreter.pad(input, target, [2, 3], 9);
+      expect(target, [1, 3, 9, 2, 4, 9]);
+    });
+
+    test('masks positions beyond the unpadded size of every axis', () {
+      final single = Float32List(6);
+      ShapeCachedInterpreter.writeMask(single, [2, 3], {1: 2});
+      expect(single, [1, 1, 0, 1, 1, 0]);
+
+      final both = Int8List(6);
+      ShapeCachedInterpreter.writeMask(both, [2, 3], {0: 1, 1: 2});
+      expect(both, [1, 1, 0, 0, 0, 0]);
+    });
+
+    test('crops outputs back to the unpadded size', () {
+      final rule = InputBucketing(
+          inputIndex: 0,
+          axis: 1,
+          buckets: [4],
+          croppedOutputAxes: const {1: 1});
+      final untouched = TensorView(Float32List.fromList([7, 8]), [2]);
+      final padded = TensorView(
+          Float32List.fromList([1, 2, 3, 4, 5, 6, 7, 8]), [2, 4]);
+      final outputs =
+          ShapeCachedInterpreter.crop([untouched, padded], {rule: 3});
+      expect(outputs[0].toList(), [7, 8]);
+      expect(outputs[1].shape, [2, 3]);
+      expect(outputs[1].isContiguous, isTrue);
+      expect(outputs[1].toList(), [
+        [1, 2, 3],
+        [5, 6, 7],
+      ]);
+    });
+  });
+}
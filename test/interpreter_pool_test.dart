@@ -0,0 +1,110 @@
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+// Doubles the float32 input after sleeping for the given milliseconds, or
+// fails when the delay is negative.
+List<TensorView> _double(List<Object> inputs, List<int>? outputIndexes) {
+  final values = inputs[0] as Float32List;
+  final delay = inputs[1] as int;
+  if (delay < 0) {
+    throw StateError('failed on purpose');
+  }
+  sleep(Duration(milliseconds: delay));
+  final out = Float32List.fromList([for (final v in values) v * 2]);
+  return [TensorView(out, [out.length])];
+}
+
+List<TensorView> Function(List<Object>, List<int>?) _createDouble() =>
+    _double;
+
+List<TensorView> Function(List<Object>, List<int>?) _createFailing() =>
+    throw StateError('no interpreter');
+
+void main() {
+  group('InterpreterPool', () {
+    late InterpreterPool pool;
+
+    tearDown(() async {
+      await pool.close();
+    });
+
+    test('dispatches to the least-loaded worker', () async {
+      pool = await InterpreterPool.withHandler(2, _createDouble);
+      final input = Float32List.fromList([1, 2]);
+      final requests = <Future<List<TensorView>>>[];
+      requests.add(pool.run([input, 200]));
+      expect(pool.pendingCounts, [1, 0]);
+      requests.add(pool.run([input, 200]));
+      expect(pool.pendingCounts, [1, 1]);
+      requests.add(pool.run([input, 0]));
+      expect(pool.pendingCounts, [2, 1]);
+
+      for (final outputs in await Future.wait(requests)) {
+        expect(outputs.single.toList(), [2.0, 4.0]);
+      }
+      expect(pool.pendingCounts, [0, 0]);
+    });
+
+    test('resizes while serving requests', () async {
+      pool = await InterpreterPool.withHandler(3, _createDouble);
+      final input = Float32List.fromList([3]);
+      final inFlight = pool.run([input, 100]);
+      await pool.resize(1);
+      expect(pool.size, 1);
+      expect((await inFlight).single.toList(), [6.0]);
+      await pool.resize(2);
+      expect(pool.size, 2);
+      expect((await pool.run([input, 0])).single.toList(), [6.0]);
+    });
+
+    test('close waits for requests in flight', () async {
+      pool = await InterpreterPool.withHandler(1, _createDouble);
+      final inFlight = pool.run([Float32List.fromList([5]), 200]);
+      final closing = pool.close();
+      expect(() => pool.run([Float32List(1), 0]), throwsStateError);
+      expect((await inFlight).single.toList(), [10.0]);
+      await closing;
+    });
+
+    test('propagates errors and keeps serving', () async {
+      pool = await InterpreterPool.withHandler(1, _createDouble);
+      await expectLater(pool.run([Float32List(1), -1]),
+          throwsA(isA<RemoteError>()));
+      expect((await pool.run([Float32List.fromList([1]), 0])).single.toList(),
+          [2.0]);
+    });
+
+    test('fails to start when a worker cannot create its handler', () async {
+      await expectLater(InterpreterPool.withHandler(2, _createFailing),
+          throwsA(isA<RemoteError>()));
+      pool = await InterpreterPool.withHandler(1, _createDouble);
+    });
+
+    test('copies outputs into typed and nested lists', () async {
+      pool = await InterpreterPool.withHandler(1, _createDouble);
+      final input = Float32List.fromList([1, 2]);
+
+      final typed = Float32List(2);
+      await pool.runForMultipleInputs([input, 0], {0: typed});
+      expect(typed, [2.0, 4.0]);
+
+      final nested = List<double>.filled(2, 0);
+      await pool.runForMultipleInputs([input, 0], {0: nested});
+      expect(nested, [2.0, 4.0]);
+
+      // Typed lists of another element type are converted element-wise.
+      final wider = Float64List(2);
+      await pool.runForMultipleInputs([input, 0], {0: wider});
+      expect(wider, [2.0, 4.0]);
+
+      // Raw byte containers take the bytes as they are.
+      final bytes = Uint8List(8);
+      await pool.runForMultipleInputs([input, 0], {0: bytes});
+      expect(bytes.buffer.asFloat32List(), [2.0, 4.0]);
+    });
+  });
+}
@@ -0,0 +1,159 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+// One ADD op that doubles a float32 [1, 2] input, resizable along dimension
+// 0. A second subgraph quadruples it; they are exported as the signatures
+// "double" and "quadruple", each with input "x" and output "y".
+Interpreter _createScale() =>
+    Interpreter.fromFile(File('test/fixtures/scale.tflite'));
+
+void _setInput(Interpreter interpreter, List<double> values) {
+  (interpreter.getInputTensor(0).typedData as Float32List).setAll(0, values);
+}
+
+List<double> _output(Interpreter interpreter) =>
+    List.of(interpreter.getOutputTensor(0).typedData as Float32List);
+
+void main() {
+  group('Interpreter.invokeAsync', () {
+    late Interpreter interpreter;
+
+    setUp(() {
+      interpreter = _createScale();
+    });
+
+    tearDown(() {
+      if (!interpreter.isDeleted) {
+        interpreter.close();
+      }
+    });
+
+    test('completes after running the model', () async {
+      _setInput(interpreter, [1.5, -2]);
+      await interpreter.invokeAsync();
+      expect(_output(interpreter), [3.0, -4.0]);
+      expect(interpreter.hasPendingAsyncInvokes, isFalse);
+    });
+
+    test('completes queued calls in order', () async {
+      _setInput(interpreter, [1, 2]);
+      final completed = <int>[];
+      final calls = [
+        for (var i = 0; i < 4; i++)
+          interpreter.invokeAsync().then((_) => completed.add(i))
+      ];
+      await Future.wait(calls);
+      expect(completed, [0, 1, 2, 3]);
+      expect(interpreter.hasPendingAsyncInvokes, isFalse);
+      expect(_output(interpreter), [2.0, 4.0]);
+    });
+
+    test('blocks synchronous calls until it completes', () async {
+      _setInput(interpreter, [1, 2]);
+      final call = interpreter.invokeAsync();
+      // Without the runtime helpers invokeAsync runs synchronously.
+      if (interpreter.hasPendingAsyncInvokes) {
+        expect(() => interpreter.invoke(), throwsStateError);
+        expect(() => interpreter.allocateTensors(), throwsStateError);
+        expect(() => interpreter.resizeInputTensor(0, [2, 2]),
+            throwsStateError);
+      }
+      await call;
+      interpreter.invoke();
+      expect(_output(interpreter), [2.0, 4.0]);
+    });
+
+    test('fails calls that close leaves unfinished', () async {
+      _setInput(interpreter, [1, 2]);
+      final outcomes = [
+        for (var i = 0; i < 3; i++)
+          interpreter.invokeAsync().then<Object>((_) => 'done',
+              onError: (Object error) => error.runtimeType)
+      ];
+      interpreter.close();
+      for (final outcome in await Future.wait(outcomes)) {
+        expect(outcome, anyOf('done', StateError));
+      }
+    });
+
+    test('rejects unallocated and closed interpreters', () async {
+      interpreter.resizeInputTensor(0, [2, 2]);
+      expect(() => interpreter.invokeAsync(), throwsStateError);
+      interpreter.allocateTensors();
+      await interpreter.invokeAsync();
+      interpreter.close();
+      expect(() => interpreter.invokeAsync(), throwsStateError);
+    });
+  });
+
+  group('Interpreter.runMany', () {
+    late Interpreter interpreter;
+
+    setUp(() {
+      interpreter = _createScale();
+    });
+
+    tearDown(() {
+      interpreter.close();
+    });
+
+    test('runs every slice and reports its latency', () async {
+      const count = 50;
+      final inputs = Float32List.fromList(
+          List.generate(count * 2, (i) => i.toDouble()));
+      final outputs = Float32List(count * 2);
+      final stats = interpreter.runMany(inputs, outputs, count);
+      expect(outputs, [for (final value in inputs) value * 2]);
+      expect(stats.count, count);
+      expect(stats.latenciesNanos.length, count);
+      expect(stats.minNanos, lessThanOrEqualTo(stats.p50Nanos));
+      expect(stats.p50Nanos, lessThanOrEqualTo(stats.p95Nanos));
+      expect(stats.p95Nanos, lessThanOrEqualTo(stats.maxNanos));
+      expect(stats.meanNanos, inInclusiveRange(stats.minNanos, stats.maxNanos));
+    });
+
+    test('reads and writes native buffers in place', () async {
+      final inputs = NativeBuffer.float32(6)..setAll(0, [1, 2, 3, 4, 5, 6]);
+      final outputs = NativeBuffer.float32(6);
+      interpreter.runMany(inputs, outputs, 3);
+      expect(outputs, [2.0, 4.0, 6.0, 8.0, 10.0, 12.0]);
+
+      // Staging buffers are reused when the batch grows.
+      final more = Float32List.fromList(List.generate(20, (i) => -i / 2));
+      final moreOutputs = Float32List(20);
+      interpreter.runMany(more, moreOutputs, 10);
+      expect(moreOutputs, [for (final value in more) value * 2]);
+    });
+
+    test('returns empty stats for no calls', () async {
+      final stats = interpreter.runMany(Float32List(0), Float32List(0), 0);
+      expect(stats.count, 0);
+      expect(stats.p99Nanos, 0);
+    });
+
+    test('rejects buffers that do not hold count slices', () async {
+      expect(() => interpreter.runMany(Float32List(5), Float32List(6), 3),
+          throwsArgumentError);
+      expect(() => interpreter.runMany(Float32List(6), Float32List(4), 3),
+          throwsArgumentError);
+      expect(() => interpreter.runMany(Float32List(0), Float32List(0), -1),
+          throwsArgumentError);
+    });
+
+    test('refuses to run while invokeAsync is pending', () async {
+      final call = interpreter.invokeAsync();
+      if (interpreter.hasPendingAsyncInvokes) {
+        expect(() => interpreter.runMany(Float32List(2), Float32List(2), 1),
+            throwsStateError);
+      }
+      await call;
+      interpreter.close();
+      expect(() => interpreter.runMany(Float32List(2), Float32List(2), 1),
+          throwsStateError);
+      interpreter = _createScale();
+    });
+  });
+}
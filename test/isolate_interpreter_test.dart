@@ -0,0 +1,104 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+// Doubles the float32 input after sleeping for the given milliseconds.
+List<TensorView> _double(List<Object> inputs) {
+  final values = inputs[0] as Float32List;
+  sleep(Duration(milliseconds: inputs[1] as int));
+  final out = Float32List.fromList([for (final v in values) v * 2]);
+  return [TensorView(out, [out.length])];
+}
+
+Future<double> _run(IsolateInterpreter interpreter, double value,
+    {int delay = 50}) async {
+  final views =
+      await interpreter.runForViews([Float32List.fromList([value]), delay]);
+  return views.single.get([0]).toDouble();
+}
+
+void main() {
+  group('IsolateInterpreter queue', () {
+    late IsolateInterpreter interpreter;
+
+    tearDown(() async {
+      await interpreter.close();
+    });
+
+    test('fifo runs every request in order', () async {
+      interpreter =
+          await IsolateInterpreter.withHandler(_double, maxQueueDepth: 1);
+      final results = [
+        for (var i = 0; i < 5; i++) _run(interpreter, i.toDouble())
+      ];
+      // Two requests are sent, one is queued and two are held back.
+      expect(interpreter.queueDepth, 3);
+      expect(await Future.wait(results), [0.0, 2.0, 4.0, 6.0, 8.0]);
+      expect(interpreter.droppedCount, 0);
+      expect(interpreter.completedCount, 5);
+    });
+
+    test('latestWins drops the oldest queued request', () async {
+      interpreter = await IsolateInterpreter.withHandler(_double,
+          maxQueueDepth: 1, policy: IsolateQueuePolicy.latestWins);
+      final first = _run(interpreter, 1);
+      final second = _run(interpreter, 2);
+      final superseded = expectLater(_run(interpreter, 3),
+          throwsA(isA<RequestDroppedException>()));
+      final latest = _run(interpreter, 4);
+      expect(interpreter.droppedCount, 1);
+      await superseded;
+      expect(await Future.wait([first, second, latest]), [2.0, 4.0, 8.0]);
+    });
+
+    test('reject fails requests beyond the queue', () async {
+      interpreter = await IsolateInterpreter.withHandler(_double,
+          maxQueueDepth: 1, policy: IsolateQueuePolicy.reject);
+      final accepted = [
+        for (var i = 1; i <= 3; i++) _run(interpreter, i.toDouble())
+      ];
+      await expectLater(
+          _run(interpreter, 4), throwsA(isA<RequestDroppedException>()));
+      expect(interpreter.droppedCount, 1);
+      expect(await Future.wait(accepted), [2.0, 4.0, 6.0]);
+    });
+
+    test('waitForRoom completes once a slot frees up', () async {
+      interpreter =
+          await IsolateInterpreter.withHandler(_double, maxQueueDepth: 0);
+      await interpreter.waitForRoom();
+      final first = _run(interpreter, 1, delay: 100);
+      final second = _run(interpreter, 2, delay: 100);
+      var ready = false;
+      final room = interpreter.waitForRoom().then((_) => ready = true);
+      await Future<void>.delayed(const Duration(milliseconds: 20));
+      expect(ready, isFalse);
+      expect(await first, 2.0);
+      await room;
+      expect(interpreter.queueDepth, 0);
+      expect(await second, 4.0);
+    });
+
+    test('close keeps requests in flight until the isolate exits', () async {
+      interpreter = await IsolateInterpreter.withHandler(_double);
+      final stopwatch = Stopwatch()..start();
+      final running = _run(interpreter, 1, delay: 300)
+          .then<Object>((value) => value, onError: (Object error) => error);
+      final pending = _run(interpreter, 2, delay: 0)
+          .then<Object>((value) => value, onError: (Object error) => error);
+      final queued = expectLater(
+          _run(interpreter, 3), throwsA(isA<RequestDroppedException>()));
+      // Let the isolate enter the handler before it is killed.
+      await Future<void>.delayed(const Duration(milliseconds: 50));
+
+      await interpreter.close();
+      await queued;
+      // Killing cannot interrupt the running request, so close waits for it.
+      expect(stopwatch.elapsedMilliseconds, greaterThanOrEqualTo(300));
+      expect(await running, anyOf(2.0, isA<RequestDroppedException>()));
+      expect(await pending, anyOf(4.0, isA<RequestDroppedException>()));
+    });
+  });
+}
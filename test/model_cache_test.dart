@@ -0,0 +1,129 @@
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  final assets = <String, Uint8List>{};
+
+  setUp(() {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMessageHandler('flutter/assets', (message) async {
+      final key = utf8.decode(message!.buffer
+          .asUint8List(message.offsetInBytes, message.lengthInBytes));
+      final bytes = assets[Uri.decodeFull(key)];
+      return bytes?.buffer.asByteData(bytes.offsetInBytes, bytes.lengthInBytes);
+    });
+  });
+
+  tearDown(() {
+    assets.clear();
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMessageHandler('flutter/assets', null);
+  });
+
+  group('ModelCache', () {
+    late Directory directory;
+    late ModelCache cache;
+
+    setUp(() async {
+      directory = await Directory.systemTemp.createTemp('model_cache_test');
+      cache = ModelCache(directory);
+    });
+
+    tearDown(() async {
+      await cache.clear();
+    });
+
+    test('content hash depends on bytes and length', () async {
+      final a = ModelCache.contentHash(Uint8List.fromList([1, 2, 3]));
+      expect(a, ModelCache.contentHash(Uint8List.fromList([1, 2, 3])));
+      expect(a, isNot(ModelCache.contentHash(Uint8List.fromList([3, 2, 1]))));
+      expect(a, endsWith('-3'));
+    });
+
+    test('put stores bytes once under their hash', () async {
+      final bytes = Uint8List.fromList(List.generate(100, (i) => i));
+      final file = await cache.put(bytes);
+      expect(file.path, cache.fileFor(ModelCache.contentHash(bytes)).path);
+      expect(await file.readAsBytes(), bytes);
+
+      final again = await cache.put(bytes);
+      expect(again.path, file.path);
+      expect(directory.listSync().length, 1);
+    });
+
+    test('streams a gzip asset into the cache and reads it back', () async {
+      final model = Uint8List.fromList(List.generate(5000, (i) => i * 7 % 251));
+      assets['assets/model.tflite.gz'] =
+          Uint8List.fromList(gzip.encode(model));
+      final runs = <DecompressionStats>[];
+
+      final file = await cache.extractCompressedAsset('assets/model.tflite.gz',
+          chunkSize: 64, onDecompressed: runs.add);
+      expect(await file.readAsBytes(), model);
+      expect(runs.single.decompressedBytes, model.length);
+      expect(runs.single.compressedBytes,
+          assets['assets/model.tflite.gz']!.length);
+      // The temp file was renamed into place.
+      expect(directory.listSync().map((entry) => entry.path), [file.path]);
+
+      final reopened = ModelCache(directory);
+      final again = await reopened.extractCompressedAsset(
+          'assets/model.tflite.gz',
+          onDecompressed: runs.add);
+      expect(again.path, file.path);
+      expect(runs.length, 1);
+    });
+
+    test('decompresses zlib and raw deflate streams', () async {
+      final model = Uint8List.fromList(List.generate(300, (i) => i % 13));
+      assets['assets/zlib.tflite.gz'] =
+          Uint8List.fromList(ZLibEncoder().convert(model));
+      assets['assets/raw.tflite.gz'] =
+          Uint8List.fromList(ZLibEncoder(raw: true).convert(model));
+
+      final zlibFile = await cache
+          .extractCompressedAsset('assets/zlib.tflite.gz', chunkSize: 5);
+      expect(await zlibFile.readAsBytes(), model);
+      final rawFile = await cache
+          .extractCompressedAsset('assets/raw.tflite.gz', chunkSize: 5);
+      expect(await rawFile.readAsBytes(), model);
+    });
+
+    test('decompresses zstd assets', () async {
+      assets['assets/model.tflite.zst'] =
+          File('test/fixtures/periodic.bin.zst').readAsBytesSync();
+      final period = List.generate(100, (i) => (i * i * 31 + i * 7) % 251);
+      final model = [for (var i = 0; i < 3500; i++) ...period];
+      final runs = <DecompressionStats>[];
+
+      final file = await cache.extractCompressedAsset(
+          'assets/model.tflite.zst',
+          onDecompressed: runs.add);
+      expect(await file.readAsBytes(), model);
+      expect(runs.single.decompressedBytes, model.length);
+      expect(directory.listSync().map((entry) => entry.path), [file.path]);
+    });
+
+    test('rejects corrupt zstd assets without leaving files behind', () async {
+      assets['assets/model.tflite.zst'] =
+          Uint8List.fromList([0x28, 0xb5, 0x2f, 0xfd, 0, 0, 0, 0]);
+      await expectLater(
+          cache.extractCompressedAsset('assets/model.tflite.zst'),
+          throwsA(isA<FormatException>()));
+      expect(directory.listSync(), isEmpty);
+    });
+
+    test('recognises compressed asset names', () async {
+      expect(ModelCache.isCompressedAssetName('assets/model.tflite.gz'), isTrue);
+      expect(ModelCache.isCompressedAssetName('assets/model.ZST'), isTrue);
+      expect(ModelCache.isCompressedAssetName('assets/model.tflite'), isFalse);
+    });
+  });
+}
@@ -0,0 +1,27 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+void main() {
+  group('NativeBuffer', () {
+    test('allocates zeroed native typed lists', () async {
+      final buffer = NativeBuffer.float32(6);
+      expect(buffer, isA<Float32List>());
+      expect(buffer, List.filled(6, 0.0));
+      expect(NativeBuffer.addressOf(buffer), isNotNull);
+      buffer[5] = 1.5;
+      expect(buffer[5], 1.5);
+    });
+
+    test('does not recognise Dart heap buffers or views', () async {
+      final buffer = NativeBuffer.int32(4);
+      expect(NativeBuffer.addressOf(Int32List(4)), isNull);
+      expect(NativeBuffer.addressOf(Int32List.sublistView(buffer, 1)), isNull);
+    });
+
+    test('rejects empty buffers', () async {
+      expect(() => NativeBuffer.uint8(0), throwsArgumentError);
+    });
+  });
+}
@@ -0,0 +1,108 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+// Exports "double" on the primary subgraph and "quadruple" on a second one,
+// each taking a float32 [n, 2] input "x" to an output "y".
+Interpreter _createScale() =>
+    Interpreter.fromFile(File('test/fixtures/scale.tflite'));
+
+void main() {
+  group('SignatureRunner', () {
+    late Interpreter interpreter;
+
+    setUp(() {
+      interpreter = _createScale();
+    });
+
+    tearDown(() {
+      if (!interpreter.isDeleted) {
+        interpreter.close();
+      }
+    });
+
+    test('lists the signatures of the model', () async {
+      expect(interpreter.signatureCount, 2);
+      expect(interpreter.signatureKeys, ['double', 'quadruple']);
+      final runner = interpreter.getSignatureRunner('quadruple');
+      expect(runner.key, 'quadruple');
+      expect(runner.inputNames, ['x']);
+      expect(runner.outputNames, ['y']);
+    });
+
+    test('runs every signature on one interpreter', () async {
+      final doubled = Float32List(2);
+      final quadrupled = Float32List(2);
+      final input = Float32List.fromList([1, 3]);
+      interpreter
+          .getSignatureRunner('double')
+          .run({'x': input}, {'y': doubled});
+      interpreter
+          .getSignatureRunner('quadruple')
+          .run({'x': input}, {'y': quadrupled});
+      expect(doubled, [2.0, 6.0]);
+      expect(quadrupled, [4.0, 12.0]);
+    });
+
+    test('reads and writes named tensors in place', () async {
+      final runner = interpreter.getSignatureRunner('quadruple');
+      expect(() => runner.invoke(), throwsStateError);
+      runner.allocateTensors();
+      final x = runner.getInputTensor('x');
+      expect(identical(runner.getInputTensor('x'), x), isTrue);
+      (x.typedData as Float32List).setAll(0, [0.5, -1]);
+      runner.invoke();
+      expect(runner.getOutputTensor('y').typedData, [2.0, -4.0]);
+    });
+
+    test('resizes inputs whose shape differs', () async {
+      final runner = interpreter.getSignatureRunner('quadruple');
+      final output = Float32List(6);
+      runner.run({
+        'x': [
+          [1.0, 2.0],
+          [3.0, 4.0],
+          [5.0, 6.0],
+        ]
+      }, {
+        'y': output
+      });
+      expect(runner.getInputTensor('x').shape, [3, 2]);
+      expect(output, [4.0, 8.0, 12.0, 16.0, 20.0, 24.0]);
+      // The primary subgraph keeps its own shape.
+      expect(interpreter.getInputTensor(0).shape, [1, 2]);
+    });
+
+    test('makes plans on a shared subgraph stale when it reallocates',
+        () async {
+      final plan = interpreter.prepare([Float32List(2)], {0: Float32List(2)});
+      final runner = interpreter.getSignatureRunner('double');
+      runner.resizeInputTensor('x', [4, 2]);
+      expect(runner.isAllocated, isFalse);
+      runner.allocateTensors();
+      expect(plan.isStale, isTrue);
+      expect(() => plan.execute(), throwsStateError);
+    });
+
+    test('caches runners and deletes them with the interpreter', () async {
+      final runner = interpreter.getSignatureRunner('double');
+      expect(identical(interpreter.getSignatureRunner('double'), runner),
+          isTrue);
+      interpreter.close();
+      expect(runner.isDeleted, isTrue);
+      expect(() => runner.invoke(), throwsStateError);
+      expect(() => interpreter.getSignatureRunner('double'), throwsStateError);
+    });
+
+    test('rejects unknown signatures and tensor names', () async {
+      expect(() => interpreter.getSignatureRunner('triple'),
+          throwsArgumentError);
+      final runner = interpreter.getSignatureRunner('double');
+      expect(() => runner.getInputTensor('y'), throwsArgumentError);
+      expect(() => runner.getOutputTensor('x'), throwsArgumentError);
+      expect(() => runner.resizeInputTensor('z', [2, 2]), throwsArgumentError);
+    });
+  });
+}
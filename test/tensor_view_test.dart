@@ -0,0 +1,79 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+void main() {
+  group('TensorView', () {
+    final data = Float32List.fromList(List.generate(24, (i) => i.toDouble()));
+
+    test('reads elements through shape and strides', () async {
+      final view = TensorView(data, [2, 3, 4]);
+      expect(view.type, TensorType.float32);
+      expect(view.strides, [12, 4, 1]);
+      expect(view.get([1, 2, 3]), 23.0);
+      expect(view.at(1, 0, 2), 14.0);
+    });
+
+    test('slice and select do not copy', () async {
+      final view = TensorView(data, [2, 3, 4]);
+      final row = view.select(0, 1).slice(0, 1, 3);
+      expect(row.shape, [2, 4]);
+      expect(row.get([0, 0]), 16.0);
+      expect(identical(row.data, view.data), isTrue);
+    });
+
+    test('transpose permutes strides', () async {
+      final view = TensorView(data, [2, 3, 4]).transpose([2, 0, 1]);
+      expect(view.shape, [4, 2, 3]);
+      expect(view.get([3, 1, 2]), 23.0);
+      expect(view.isContiguous, isFalse);
+      expect(view.copy().isContiguous, isTrue);
+      expect(view.copy().get([3, 1, 2]), 23.0);
+    });
+
+    test('set writes to the backing buffer', () async {
+      final buffer = Int32List(4);
+      TensorView(buffer, [2, 2]).set([1, 0], 7);
+      expect(buffer, [0, 0, 7, 0]);
+    });
+
+    test('toList materializes nested lists', () async {
+      final view = TensorView(Int32List.fromList([1, 2, 3, 4]), [2, 2]);
+      expect(view.transpose().toList(), [
+        [1, 3],
+        [2, 4],
+      ]);
+    });
+
+    test('copyInto converts to the target element type', () async {
+      final floats = Float32List.fromList([1.5, -2.25, 3, 4]);
+      final wide = Float64List(4);
+      TensorView(floats, [2, 2]).copyInto(wide);
+      expect(wide, [1.5, -2.25, 3, 4]);
+
+      final bytes = Int8List.fromList([-1, 2, -3, 4]);
+      final asFloats = Float32List(4);
+      TensorView(bytes, [4]).copyInto(asFloats);
+      expect(asFloats, [-1, 2, -3, 4]);
+
+      final unsigned = Uint8List(4);
+      TensorView(bytes, [4]).copyInto(unsigned);
+      expect(unsigned, [255, 2, 253, 4]);
+
+      final same = Int8List(4);
+      TensorView(bytes, [4]).copyInto(same);
+      expect(same, bytes);
+    });
+
+    test('copyInto rejects float views into integer targets', () async {
+      expect(() => TensorView(data, [24]).copyInto(Int32List(24)),
+          throwsA(isA<ArgumentError>()));
+    });
+
+    test('rejects shape mismatches', () async {
+      expect(() => TensorView(Float32List(5), [2, 3]),
+          throwsA(isA<ArgumentError>()));
+    });
+  });
+}
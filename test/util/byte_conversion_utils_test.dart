@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:flutter_litert/flutter_litert.dart';
 
@@ -101,6 +103,43 @@ void main() {
     });
   });
 
+  group('nested lists', () {
+    test('float32 nested list flattens in row-major order', () async {
+      var bytes = ByteConversionUtils.convertObjectToBytes([
+        [1.0, 2.0, 3.0],
+        [4, 5, 6.5],
+      ], TensorType.float32);
+      expect(bytes,
+          Float32List.fromList([1, 2, 3, 4, 5, 6.5]).buffer.asUint8List());
+    });
+
+    test('flattenInto writes into the target buffer', () async {
+      var target = Int32List(4);
+      ByteConversionUtils.flattenInto([
+        [1, 2],
+        [3, 4],
+      ], target, TensorType.int32);
+      expect(target, [1, 2, 3, 4]);
+    });
+
+    test('flattenInto rejects ragged lists', () async {
+      expect(
+          () => ByteConversionUtils.flattenInto([
+                [1, 2],
+                [3],
+              ], Int32List(4), TensorType.int32),
+          throwsA(isA<ArgumentError>()));
+    });
+
+    test('convertBytesToObject returns nested rows', () async {
+      var bytes = Float32List.fromList([1, 2, 3, 4, 5, 6]).buffer.asUint8List();
+      var object = ByteConversionUtils.convertBytesToObject(
+          bytes, TensorType.float32, [2, 3]);
+      expect(object, isA<List<List<double>>>());
+      expect((object as List)[1][2], 6.0);
+    });
+  });
+
   group('errors', () {
     test('float to int8', () async {
       expect(
@@ -114,5 +153,42 @@ void main() {
               ByteConversionUtils.convertObjectToBytes(1.1, TensorType.noType),
           throwsA(isA<ArgumentError>()));
     });
+
+    test('float list to int32', () async {
+      expect(
+          () => ByteConversionUtils.convertObjectToBytes([
+                [1.5, 2.5],
+              ], TensorType.int32),
+          throwsA(isA<ByteConversionError>()));
+    });
+  });
+
+  group('typed lists of another element type', () {
+    test('Float64List converts to float32 elements', () {
+      final bytes = ByteConversionUtils.convertObjectToBytes(
+          Float64List.fromList([1.5, -2.0]), TensorType.float32);
+      expect(bytes.length, 8);
+      expect(bytes.buffer.asFloat32List(bytes.offsetInBytes, 2), [1.5, -2.0]);
+    });
+
+    test('Int32List converts to int32 values of an int16 tensor', () {
+      final bytes = ByteConversionUtils.convertObjectToBytes(
+          Int32List.fromList([1, -3]), TensorType.int16);
+      expect(bytes.buffer.asInt16List(bytes.offsetInBytes, 2), [1, -3]);
+    });
+
+    test('matching typed lists are passed through as raw bytes', () {
+      final data = Float32List.fromList([1, 2]);
+      final bytes =
+          ByteConversionUtils.convertObjectToBytes(data, TensorType.float32);
+      expect(identical(bytes.buffer, data.buffer), isTrue);
+      expect(
+          ByteConversionUtils.matchesTensorType(
+              Float64List(1), TensorType.float32),
+          isFalse);
+      expect(
+          ByteConversionUtils.matchesTensorType(Uint8List(4), TensorType.int32),
+          isTrue);
+    });
   });
 }
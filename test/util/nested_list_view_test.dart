@@ -0,0 +1,43 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+void main() {
+  group('NestedListView', () {
+    test('exposes a flat buffer with the given shape', () async {
+      var flat = Int32List.fromList(List.generate(8, (i) => i));
+      var view = NestedListView.of(flat, [2, 2, 2]);
+      expect(view, isA<List<List<List<int>>>>());
+      expect(view.length, 2);
+      expect(view[1][0][1], 5);
+      expect(view, [
+        [
+          [0, 1],
+          [2, 3],
+        ],
+        [
+          [4, 5],
+          [6, 7],
+        ],
+      ]);
+    });
+
+    test('element writes go to the backing buffer', () async {
+      var flat = Float32List(6);
+      var view = NestedListView.of(flat, [2, 3]);
+      view[1][2] = 3.5;
+      expect(flat[5], 3.5);
+    });
+
+    test('is fixed length', () async {
+      var view = NestedListView.of(Float32List(4), [2, 2]);
+      expect(() => view.add([0.0, 0.0]), throwsUnsupportedError);
+    });
+
+    test('rejects shape mismatches', () async {
+      expect(() => NestedListView.of(Float32List(5), [2, 3]),
+          throwsA(isA<ArgumentError>()));
+    });
+  });
+}
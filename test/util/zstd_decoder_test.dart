@@ -0,0 +1,92 @@
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_litert/flutter_litert.dart';
+
+Uint8List _decode(Uint8List input) {
+  final builder = BytesBuilder();
+  ZstdDecoder.decode(input, builder.add);
+  return builder.takeBytes();
+}
+
+Uint8List _fixture(String name) =>
+    File('test/fixtures/$name').readAsBytesSync();
+
+Uint8List _hex(String hex) => Uint8List.fromList([
+      for (var i = 0; i < hex.length; i += 2)
+        int.parse(hex.substring(i, i + 2), radix: 16)
+    ]);
+
+void main() {
+  group('ZstdDecoder', () {
+    // Written by `zstd -19` from stdin: Huffman literals with FSE-compressed
+    // weights, FSE sequence tables and a content checksum, no content size.
+    final tokens = utf8.encode(List.generate(
+        3000, (i) => 'token${i % 37} value${(i * 7) % 13}\n').join());
+
+    test('recognises zstd frames', () async {
+      expect(ZstdDecoder.isZstd(_fixture('tokens.txt.zst')), isTrue);
+      expect(ZstdDecoder.isZstd(Uint8List.fromList(gzip.encode([1]))),
+          isFalse);
+      expect(ZstdDecoder.isZstd(Uint8List(2)), isFalse);
+    });
+
+    test('decodes a compressed frame with a checksum', () async {
+      expect(_decode(_fixture('tokens.txt.zst')), tokens);
+    });
+
+    test('slides a small window over a long frame', () async {
+      // `zstd -19 --zstd=wlog=10`: a 1 KiB window over 350 000 bytes.
+      final period = List.generate(100, (i) => (i * i * 31 + i * 7) % 251);
+      final expected = [for (var i = 0; i < 3500; i++) ...period];
+      var chunks = 0;
+      final builder = BytesBuilder();
+      ZstdDecoder.decode(_fixture('periodic.bin.zst'), (chunk) {
+        chunks++;
+        builder.add(chunk);
+      });
+      expect(builder.takeBytes(), expected);
+      expect(chunks, greaterThan(1));
+    });
+
+    test('decodes raw and RLE blocks across frames', () async {
+      // `zstd -19` of 1000 'a's (an RLE block) and `zstd --no-check` of 86
+      // incompressible bytes (a raw block), with a skippable frame between.
+      final rle = _hex('28b52ffd046845000008610100e42b20042342da2e');
+      final rawBytes = List.generate(86, (i) => i * 3);
+      final raw = Uint8List.fromList(
+          [0x28, 0xb5, 0x2f, 0xfd, 0x00, 0x68, 0xb1, 0x02, 0x00, ...rawBytes]);
+      final skippable = Uint8List.fromList(
+          [0x50, 0x2a, 0x4d, 0x18, 0x03, 0x00, 0x00, 0x00, 1, 2, 3]);
+
+      final decoded =
+          _decode(Uint8List.fromList([...rle, ...skippable, ...raw]));
+      expect(decoded.sublist(0, 1000), everyElement(0x61));
+      expect(decoded.sublist(1000), rawBytes);
+    });
+
+    test('rejects corrupt data', () async {
+      final corrupt = Uint8List.fromList(_fixture('tokens.txt.zst'));
+      corrupt[corrupt.length - 1] ^= 1;
+      expect(() => _decode(corrupt), throwsFormatException);
+
+      final truncated = _fixture('tokens.txt.zst').sublist(0, 200);
+      expect(() => _decode(truncated), throwsFormatException);
+
+      expect(() => _decode(Uint8List.fromList([1, 2, 3, 4, 5])),
+          throwsFormatException);
+    });
+
+    test('rejects dictionaries and oversized windows', () async {
+      // Frame headers with a one-byte dictionary ID, and a 256 MiB window.
+      final dictionary = Uint8List.fromList(
+          [0x28, 0xb5, 0x2f, 0xfd, 0x01, 0x00, 0x07, 0x01, 0x00, 0x00]);
+      expect(() => _decode(dictionary), throwsUnsupportedError);
+      final window = Uint8List.fromList(
+          [0x28, 0xb5, 0x2f, 0xfd, 0x00, 0x90, 0x01, 0x00, 0x00]);
+      expect(() => _decode(window), throwsUnsupportedError);
+    });
+  });
+}